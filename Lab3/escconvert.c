@@ -0,0 +1,174 @@
+/**
+ * The streaming escape converter.
+ *
+ * Input characters should be transferred directly, except for the
+ * following two cases:
+ * - non-escaped actual newline characters in the input should cause
+ *   the "line leader" to be printed out and the line number incremented
+ * - any character following the escape character '\' may have a
+ *   special meaing as follows:
+ *      n : generate a "new line" character (with no "line leader")
+ *      t : generate a tab character
+ *      ' : generate a single quote character
+ *     \n : (an actual newline character) in this case,
+ *          generate nothing -- that is, the input should be as though
+ *          this escaped end-of-line character never existed
+ *      \ : (i.e.; the escape character itself) this should
+ *          generate a '\' character
+ *        : any other escaped character simply has it "unescaped" meaning,
+ *          for example the sequence "\Q" would simply output a "Q"
+ */
+#include <stdio.h>	/* for snprintf() */
+
+#include "escscan.h"
+#include "escconvert.h"
+
+
+int
+escFormatLeader(char *buffer, size_t bufsize, int lineNumber)
+{
+	return snprintf(buffer, bufsize, "\n%4d >:", lineNumber);
+}
+
+static int
+escEmitLeader(EscConverter *conv, int lineNumber)
+{
+	char leader[ESC_LEADER_BUFFER_SIZE];
+	int len;
+
+	if (conv->sink.leader != NULL)
+		return (*conv->sink.leader)(conv->sink.sinkdata, lineNumber);
+
+	len = escFormatLeader(leader, sizeof(leader), lineNumber);
+	return (*conv->sink.write)(conv->sink.sinkdata, leader, len);
+}
+
+static int
+escEmit(EscConverter *conv, const char *buffer, size_t len)
+{
+	return (*conv->sink.write)(conv->sink.sinkdata, buffer, len);
+}
+
+void
+escInit(EscConverter *conv, const EscSink *sink)
+{
+	escResume(conv, sink, 0, 0, 0);
+	conv->needFirstLeader = 1;
+}
+
+void
+escResume(EscConverter *conv, const EscSink *sink,
+		int lineNumber, int isInEscape, unsigned long long inOffset)
+{
+	conv->sink = *sink;
+	conv->lineNumber = lineNumber;
+	conv->isInEscape = isInEscape;
+	conv->needFirstLeader = 0;
+	conv->status = 0;
+	conv->inOffset = inOffset;
+}
+
+/**
+ * Convert one buffer of input, carrying on from whatever state the
+ * previous buffer left us in.  A buffer may end anywhere, including
+ * just after an escape character.
+ *
+ * Rather than looking at every character, escFindSpecial() is used
+ * to skip over the runs of plain characters, which are sent to the
+ * sink in one call.  The escape handling below only runs at the '\'
+ * and newline characters themselves.
+ *
+ * Returns 0, or the first non-zero value returned by the sink (which
+ * is also returned by every later call on this converter).
+ */
+int
+escFeed(EscConverter *conv, const char *buffer, size_t len)
+{
+	unsigned long long base = conv->inOffset;
+	size_t pos = 0, run;
+	char c;
+
+	if (conv->status != 0)
+		return conv->status;
+
+	if (conv->needFirstLeader) {
+		conv->needFirstLeader = 0;
+		if ((conv->status = escEmitLeader(conv, ++conv->lineNumber)) != 0)
+			return conv->status;
+	}
+
+	while (pos < len) {
+
+		if (conv->isInEscape) {
+			/**
+			 * the escape may have been the last character
+			 * of the previous buffer, so this is checked
+			 * before looking for the next run
+			 */
+			c = buffer[pos++];
+			conv->inOffset = base + pos;
+
+			//now done escaping
+			conv->isInEscape = 0;
+
+			//special cases for the escaped characters
+			if (c == 'n') //new line
+			{
+				conv->status = escEmit(conv, "\n", 1);
+			} else if (c == 10) //if the char to escape its meaning is an actual new line char
+			{
+				//do nothing
+			} else if (c == 't') //if the char to escape its meaning is a tab char
+			{
+				//do a tab
+				conv->status = escEmit(conv, "\t", 1);
+			}
+			else {
+				conv->status = escEmit(conv, &c, 1);
+			}
+
+			if (conv->status != 0)
+				return conv->status;
+			continue;
+		}
+
+		/** copy out everything up to the next '\' or newline */
+		run = escFindSpecial(&buffer[pos], len - pos);
+		if (run > 0) {
+			conv->inOffset = base + pos + run;
+			if ((conv->status = escEmit(conv, &buffer[pos], run)) != 0)
+				return conv->status;
+			pos += run;
+		}
+		if (pos >= len)
+			break;
+
+		c = buffer[pos++];
+		conv->inOffset = base + pos;
+		if (c == '\\') {
+			/** flag that we just saw an escape character */
+			conv->isInEscape = 1;
+		} else { //an actual new line character
+			if ((conv->status = escEmitLeader(conv, ++conv->lineNumber)) != 0)
+				return conv->status;
+		}
+	}
+
+	conv->inOffset = base + len;
+	return 0;
+}
+
+/**
+ * An escape character at the very end of the input has nothing to
+ * escape, so it is simply dropped.  The first line leader is still
+ * produced for an empty input.
+ */
+int
+escFinish(EscConverter *conv)
+{
+	if (conv->status == 0 && conv->needFirstLeader)
+		escFeed(conv, NULL, 0);
+
+	conv->isInEscape = 0;
+	return conv->status;
+}
@@ -0,0 +1,71 @@
+/**
+ * Header file for the streaming escape converter.
+ *
+ * The converter is fed the input in buffers of any size (down to
+ * one character at a time) and keeps its escape and line number
+ * state from one buffer to the next, sending its output to a sink
+ * supplied by the caller.
+ */
+
+#ifndef	__ESCAPE_CONVERTER_HEADER__
+#define	__ESCAPE_CONVERTER_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+/** big enough for a formatted line leader with any line number */
+#define	ESC_LEADER_BUFFER_SIZE	32
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+/**
+ * Where the converted output goes.  Each callback returns 0 to keep
+ * going; any other value stops the conversion and is handed back to
+ * the caller of escFeed()/escFinish().
+ *
+ * If "leader" is NULL the converter formats the line leader itself
+ * and sends it through "write" like any other output.
+ */
+typedef struct EscSink {
+	int (*write)(void *sinkdata, const char *buffer, size_t len);
+	int (*leader)(void *sinkdata, int lineNumber);
+	void *sinkdata;
+} EscSink;
+
+/**
+ * inOffset counts the input characters consumed so far; within a
+ * leader callback it is the offset just after the newline that
+ * started the new line
+ */
+typedef struct EscConverter {
+	EscSink sink;
+	int lineNumber;
+	int isInEscape;
+	int needFirstLeader;
+	int status;
+	unsigned long long inOffset;
+} EscConverter;
+
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up a converter at the start of a new input */
+void escInit(EscConverter *conv, const EscSink *sink);
+
+/* set up a converter part way through an input, with the given state */
+void escResume(EscConverter *conv, const EscSink *sink,
+		int lineNumber, int isInEscape, unsigned long long inOffset);
+
+/* convert the next buffer of input */
+int escFeed(EscConverter *conv, const char *buffer, size_t len);
+
+/* finish off the input -- no more calls to escFeed() may follow */
+int escFinish(EscConverter *conv);
+
+/* format a line leader into buffer, returning its length */
+int escFormatLeader(char *buffer, size_t bufsize, int lineNumber);
+
+#endif	/* __ESCAPE_CONVERTER_HEADER__ */
@@ -0,0 +1,296 @@
+/**
+ * Writing and using the line offset "sidecar" index.
+ *
+ * The index file is a header followed by fixed size checkpoints,
+ * so finding the checkpoint for a line is a single fseek().
+ */
+#include <stdio.h>
+#include <stdlib.h>	/* for malloc() */
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>	/* for stat() */
+
+#include "escindex.h"
+
+#define	ESC_INDEX_MAGIC		"L3IX"
+#define	ESC_INDEX_VERSION	2
+
+/** how much of the input we read at one time when seeking */
+#define	SEEK_BUFFER_SIZE	(16 * 1024)
+
+/** returned through the converter once we have passed the wanted line */
+#define	SEEK_PAST_WANTED_LINE	0x5eec
+
+
+char *
+escIndexFilename(const char *inputFilename)
+{
+	char *name;
+
+	name = (char *) malloc(strlen(inputFilename) + strlen(ESC_INDEX_SUFFIX) + 1);
+	if (name != NULL) {
+		strcpy(name, inputFilename);
+		strcat(name, ESC_INDEX_SUFFIX);
+	}
+	return name;
+}
+
+
+/**
+ * EscSink callbacks that count the output and record a checkpoint
+ * at every "interval"th line before passing everything on
+ */
+static int
+indexWrite(void *sinkdata, const char *buffer, size_t len)
+{
+	EscIndexWriter *iw = (EscIndexWriter *) sinkdata;
+
+	iw->outOffset += len;
+	return (*iw->target.write)(iw->target.sinkdata, buffer, len);
+}
+
+static int
+indexLeader(void *sinkdata, int lineNumber)
+{
+	EscIndexWriter *iw = (EscIndexWriter *) sinkdata;
+	EscIndexCheckpoint checkpoint;
+	char leader[ESC_LEADER_BUFFER_SIZE];
+	int len;
+
+	if ((lineNumber - 1) % iw->header.interval == 0) {
+		memset(&checkpoint, 0, sizeof(checkpoint));
+		checkpoint.inOffset = iw->conv->inOffset;
+		checkpoint.outOffset = iw->outOffset;
+		checkpoint.lineNumber = lineNumber;
+		checkpoint.isInEscape = iw->conv->isInEscape;
+		if (fwrite(&checkpoint, sizeof(checkpoint), 1, iw->ofp) != 1)
+			return -1;
+		iw->header.nCheckpoints++;
+	}
+
+	/**
+	 * the output offsets assume the target produces the standard
+	 * leader, whether it formats it itself or not
+	 */
+	len = escFormatLeader(leader, sizeof(leader), lineNumber);
+	iw->outOffset += len;
+	if (iw->target.leader != NULL)
+		return (*iw->target.leader)(iw->target.sinkdata, lineNumber);
+	return (*iw->target.write)(iw->target.sinkdata, leader, len);
+}
+
+int
+escIndexWriterInit(EscIndexWriter *iw, EscConverter *conv,
+		const EscSink *target, int inputFd,
+		const char *indexFilename, int interval)
+{
+	EscSink sink;
+	struct stat sb;
+
+	memset(iw, 0, sizeof(EscIndexWriter));
+	if (fstat(inputFd, &sb) < 0)
+		return -1;
+	iw->ofp = fopen(indexFilename, "wb");
+	if (iw->ofp == NULL)
+		return -1;
+
+	memcpy(iw->header.magic, ESC_INDEX_MAGIC, sizeof(iw->header.magic));
+	iw->header.version = ESC_INDEX_VERSION;
+	iw->header.interval = (interval > 0) ? interval : ESC_INDEX_DEFAULT_INTERVAL;
+
+	/**
+	 * taken before any input is read, so that a change made while
+	 * we are converting also leaves the index stale
+	 */
+	iw->header.inputMtime = (long long) sb.st_mtim.tv_sec;
+	iw->header.inputMtimeNsec = (unsigned int) sb.st_mtim.tv_nsec;
+	iw->header.inputInode = (unsigned long long) sb.st_ino;
+
+	/** the counts are filled in when we close the index */
+	if (fwrite(&iw->header, sizeof(iw->header), 1, iw->ofp) != 1) {
+		fclose(iw->ofp);
+		return -1;
+	}
+
+	iw->target = *target;
+	iw->conv = conv;
+
+	sink.write = indexWrite;
+	sink.leader = indexLeader;
+	sink.sinkdata = iw;
+	escInit(conv, &sink);
+	return 0;
+}
+
+/**
+ * Write the final header into the index.  If the conversion failed
+ * the index is left incomplete (with no input size recorded) so that
+ * it will never be mistaken for a good one.
+ */
+int
+escIndexWriterClose(EscIndexWriter *iw, int conversionStatus)
+{
+	int status = 0;
+
+	if (conversionStatus == 0) {
+		iw->header.inputSize = iw->conv->inOffset;
+		if (fseek(iw->ofp, 0, SEEK_SET) != 0
+				|| fwrite(&iw->header, sizeof(iw->header), 1, iw->ofp) != 1)
+			status = -1;
+	}
+	if (fclose(iw->ofp) != 0)
+		status = -1;
+	return status;
+}
+
+
+/**
+ * State for producing a single line, passed as the sink data
+ * while seeking
+ */
+typedef struct SeekWindow {
+	const EscSink *target;
+	int currentLine;
+	int wantedLine;
+} SeekWindow;
+
+static int
+seekWrite(void *sinkdata, const char *buffer, size_t len)
+{
+	SeekWindow *window = (SeekWindow *) sinkdata;
+
+	if (window->currentLine != window->wantedLine)
+		return 0;
+	return (*window->target->write)(window->target->sinkdata, buffer, len);
+}
+
+static int
+seekLeader(void *sinkdata, int lineNumber)
+{
+	SeekWindow *window = (SeekWindow *) sinkdata;
+	char leader[ESC_LEADER_BUFFER_SIZE];
+	int len;
+
+	window->currentLine = lineNumber;
+
+	/** returning non-zero stops the converter once we are past our line */
+	if (lineNumber > window->wantedLine)
+		return SEEK_PAST_WANTED_LINE;
+	if (lineNumber < window->wantedLine)
+		return 0;
+
+	if (window->target->leader != NULL)
+		return (*window->target->leader)(window->target->sinkdata, lineNumber);
+	len = escFormatLeader(leader, sizeof(leader), lineNumber);
+	return (*window->target->write)(window->target->sinkdata, leader, len);
+}
+
+/**
+ * Read the checkpoint at or before the given line
+ */
+static int
+readCheckpoint(FILE *ifp, const EscIndexHeader *header,
+		int lineNumber, EscIndexCheckpoint *checkpoint)
+{
+	unsigned long long which;
+
+	which = (lineNumber - 1) / header->interval;
+	if (which >= header->nCheckpoints)
+		which = header->nCheckpoints - 1;
+
+	if (fseek(ifp, sizeof(EscIndexHeader)
+				+ which * sizeof(EscIndexCheckpoint), SEEK_SET) != 0
+			|| fread(checkpoint, sizeof(EscIndexCheckpoint), 1, ifp) != 1)
+		return -1;
+	return 0;
+}
+
+/**
+ * Produce the converted text of line "lineNumber" of the input
+ * (starting with its line leader), resuming the conversion from the
+ * nearest checkpoint in the index so that at most "interval" lines
+ * of input need to be converted.
+ *
+ * Returns 0 on success, -1 on failure (with errno set),
+ * ESC_SEEK_NO_SUCH_LINE if the input has fewer lines than that, or
+ * ESC_SEEK_STALE_INDEX if the index does not match the input.
+ */
+int
+escSeekLine(const char *inputFilename, const char *indexFilename,
+		int lineNumber, const EscSink *sink)
+{
+	char buffer[SEEK_BUFFER_SIZE];
+	EscIndexHeader header;
+	EscIndexCheckpoint checkpoint;
+	EscConverter conv;
+	EscSink windowSink;
+	SeekWindow window;
+	struct stat sb;
+	FILE *indexfp, *ifp;
+	size_t nRead;
+	int status = 0;
+
+	if (lineNumber < 1)
+		return ESC_SEEK_NO_SUCH_LINE;
+
+	indexfp = fopen(indexFilename, "rb");
+	if (indexfp == NULL)
+		return -1;
+
+	if (fread(&header, sizeof(header), 1, indexfp) != 1
+			|| memcmp(header.magic, ESC_INDEX_MAGIC, sizeof(header.magic)) != 0
+			|| header.version != ESC_INDEX_VERSION
+			|| header.interval == 0
+			|| header.nCheckpoints == 0
+			|| stat(inputFilename, &sb) < 0
+			|| (unsigned long long) sb.st_size != header.inputSize
+			|| (long long) sb.st_mtim.tv_sec != header.inputMtime
+			|| (unsigned int) sb.st_mtim.tv_nsec != header.inputMtimeNsec
+			|| (unsigned long long) sb.st_ino != header.inputInode) {
+		fclose(indexfp);
+		return ESC_SEEK_STALE_INDEX;
+	}
+
+	status = readCheckpoint(indexfp, &header, lineNumber, &checkpoint);
+	fclose(indexfp);
+	if (status < 0)
+		return ESC_SEEK_STALE_INDEX;
+
+	ifp = fopen(inputFilename, "rb");
+	if (ifp == NULL)
+		return -1;
+	if (fseeko(ifp, (off_t) checkpoint.inOffset, SEEK_SET) != 0) {
+		fclose(ifp);
+		return -1;
+	}
+
+	window.target = sink;
+	window.currentLine = checkpoint.lineNumber;
+	window.wantedLine = lineNumber;
+	windowSink.write = seekWrite;
+	windowSink.leader = seekLeader;
+	windowSink.sinkdata = &window;
+
+	/**
+	 * the checkpoint is taken just before the leader for its line,
+	 * so we produce that leader ourselves if it is the one we want
+	 */
+	escResume(&conv, &windowSink, checkpoint.lineNumber,
+			checkpoint.isInEscape, checkpoint.inOffset);
+	if (checkpoint.lineNumber == (unsigned int) lineNumber)
+		status = seekLeader(&window, lineNumber);
+
+	while (status == 0 && (nRead = fread(buffer, 1, sizeof(buffer), ifp)) > 0) {
+		status = escFeed(&conv, buffer, nRead);
+	}
+	if (status == 0 && ferror(ifp))
+		status = -1;
+	fclose(ifp);
+
+	/** stopping at the next leader is how we know we are done */
+	if (status == SEEK_PAST_WANTED_LINE)
+		return 0;
+	if (status == 0 && window.currentLine < lineNumber)
+		return ESC_SEEK_NO_SUCH_LINE;
+	return status;
+}
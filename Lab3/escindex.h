@@ -0,0 +1,90 @@
+/**
+ * Header file for the line offset "sidecar" index.
+ *
+ * While a file is being converted, a checkpoint is written to the
+ * index every "interval" lines recording where that line starts in
+ * both the input and the converted output, along with the escape
+ * state at that point.  Any line can then be produced by resuming
+ * the converter at the nearest checkpoint before it, instead of
+ * converting the whole file from the start.
+ */
+
+#ifndef	__ESCAPE_INDEX_HEADER__
+#define	__ESCAPE_INDEX_HEADER__
+
+#include <stdio.h>
+
+#include "escconvert.h"
+
+/** the name of an index is the name of the input with this added */
+#define	ESC_INDEX_SUFFIX			".l3idx"
+
+#define	ESC_INDEX_DEFAULT_INTERVAL	1024
+
+/** values returned by escSeekLine() other than 0 and -1 */
+#define	ESC_SEEK_NO_SUCH_LINE		1
+#define	ESC_SEEK_STALE_INDEX		2
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+/**
+ * The start of an index file.  The size, modification time and
+ * inode of the input are recorded so that an index left behind by
+ * an earlier version of the input (even one of the same size, or a
+ * new file renamed into its place) is never used.
+ */
+typedef struct EscIndexHeader {
+	char magic[4];
+	unsigned int version;
+	unsigned int interval;
+	unsigned int inputMtimeNsec;
+	unsigned long long nCheckpoints;
+	unsigned long long inputSize;
+	long long inputMtime;
+	unsigned long long inputInode;
+} EscIndexHeader;
+
+/** one checkpoint, for the start of line "lineNumber" */
+typedef struct EscIndexCheckpoint {
+	unsigned long long inOffset;
+	unsigned long long outOffset;
+	unsigned int lineNumber;
+	unsigned int isInEscape;
+} EscIndexCheckpoint;
+
+/**
+ * State for writing an index while converting.  Output passes
+ * through this on its way to the real sink so that we can keep
+ * track of where each line starts in it.
+ */
+typedef struct EscIndexWriter {
+	EscSink target;
+	EscConverter *conv;
+	FILE *ofp;
+	EscIndexHeader header;
+	unsigned long long outOffset;
+} EscIndexWriter;
+
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* build the index file name for an input file -- free() the result */
+char *escIndexFilename(const char *inputFilename);
+
+/* create the index file for the input open on inputFd and start conv */
+int escIndexWriterInit(EscIndexWriter *iw, EscConverter *conv,
+		const EscSink *target, int inputFd,
+		const char *indexFilename, int interval);
+
+/* finish the index once the converter is finished */
+int escIndexWriterClose(EscIndexWriter *iw, int conversionStatus);
+
+/* send the converted text of a single line (with its leader) to sink */
+int escSeekLine(const char *inputFilename, const char *indexFilename,
+		int lineNumber, const EscSink *sink);
+
+#endif	/* __ESCAPE_INDEX_HEADER__ */
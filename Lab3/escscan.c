@@ -0,0 +1,76 @@
+/**
+ * Find the "special" characters (escapes and newlines) in a
+ * buffer, 32 bytes at a time where the processor allows it.
+ *
+ * Almost all of the characters in typical input are plain text
+ * that is simply copied, so the converter only needs to stop
+ * at the positions this scanner reports.
+ */
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "escscan.h"
+
+
+/**
+ * Check a single byte -- used for the tail of the buffer
+ * that is too short to fill a vector register
+ */
+static size_t
+escFindSpecialScalar(const char *buffer, size_t pos, size_t len)
+{
+	while (pos < len) {
+		if (buffer[pos] == ESC_ESCAPE_CHAR || buffer[pos] == ESC_NEWLINE_CHAR)
+			return pos;
+		pos++;
+	}
+	return len;
+}
+
+size_t
+escFindSpecial(const char *buffer, size_t len)
+{
+	size_t pos = 0;
+
+#if defined(__AVX2__)
+	const __m256i escapes = _mm256_set1_epi8(ESC_ESCAPE_CHAR);
+	const __m256i newlines = _mm256_set1_epi8(ESC_NEWLINE_CHAR);
+	__m256i block;
+	unsigned int mask;
+
+	for ( ; pos + 32 <= len; pos += 32) {
+		block = _mm256_loadu_si256((const __m256i *) &buffer[pos]);
+		mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_cmpeq_epi8(block, escapes),
+					_mm256_cmpeq_epi8(block, newlines)));
+		if (mask != 0)
+			return pos + __builtin_ctz(mask);
+	}
+#elif defined(__SSE2__)
+	/**
+	 * Without AVX2 we still look at 32 bytes per step, as two
+	 * 16 byte halves whose masks are joined together
+	 */
+	const __m128i escapes = _mm_set1_epi8(ESC_ESCAPE_CHAR);
+	const __m128i newlines = _mm_set1_epi8(ESC_NEWLINE_CHAR);
+	__m128i low, high;
+	unsigned int mask;
+
+	for ( ; pos + 32 <= len; pos += 32) {
+		low = _mm_loadu_si128((const __m128i *) &buffer[pos]);
+		high = _mm_loadu_si128((const __m128i *) &buffer[pos + 16]);
+		mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(
+					_mm_cmpeq_epi8(low, escapes),
+					_mm_cmpeq_epi8(low, newlines)))
+			| ((unsigned int) _mm_movemask_epi8(_mm_or_si128(
+					_mm_cmpeq_epi8(high, escapes),
+					_mm_cmpeq_epi8(high, newlines))) << 16);
+		if (mask != 0)
+			return pos + __builtin_ctz(mask);
+	}
+#endif
+
+	return escFindSpecialScalar(buffer, pos, len);
+}
@@ -0,0 +1,22 @@
+/**
+ * Header file for the vectorized scanner used to find the
+ * characters that the escape converter has to look at.
+ */
+
+#ifndef	__ESCAPE_SCANNER_HEADER__
+#define	__ESCAPE_SCANNER_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+/** the two characters that have a meaning to the converter */
+#define	ESC_ESCAPE_CHAR		'\\'
+#define	ESC_NEWLINE_CHAR	'\n'
+
+/**
+ * Return the offset of the first escape or newline character in
+ * the given buffer, or len if there is none.  Everything before
+ * the returned offset can be copied to the output as-is.
+ */
+size_t escFindSpecial(const char *buffer, size_t len);
+
+#endif	/* __ESCAPE_SCANNER_HEADER__ */
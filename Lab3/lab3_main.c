@@ -2,6 +2,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>	/* for isatty() */
+#include <fcntl.h>	/* for open() */
+#include <pthread.h>
+#include <sys/mman.h>	/* for mmap() */
+#include <sys/stat.h>	/* for fstat() */
+
+#include "escconvert.h"
+#include "escindex.h"
+
+/** how much of the input file we read in at one time */
+#define	INPUT_BUFFER_SIZE	(64 * 1024)
+
+/** how much of the input each thread translates at one time in parallel mode */
+#ifndef	PARALLEL_CHUNK_SIZE
+#define	PARALLEL_CHUNK_SIZE	(16 * 1024 * 1024)
+#endif
+
+/** the most threads we will run in parallel mode */
+#define	MAX_THREADS	64
+
+/** set once in main(): is there someone watching the output as it comes? */
+static int stdoutIsTerminal = 0;
 
 
 static void
@@ -13,36 +35,54 @@ printLineLeader(int lineNumber)
 	 * the current line are pushed to the output device (the terminal)
 	 * even though there is no newline at the end of the above output
 	 * string.
+	 *
+	 * This is only needed when someone is watching -- flushing on
+	 * every line when writing into a file or a pipe would cost far
+	 * more than the conversion itself.
 	 */
-	fflush(stdout);
+	if (stdoutIsTerminal)
+		fflush(stdout);
+}
+
+/**
+ * EscSink callbacks writing directly to stdout.  The line leaders
+ * go out through printf(), which does not tell us if it failed, so
+ * the error flag on stdout is checked as well.
+ */
+static int
+stdoutWrite(void *sinkdata, const char *buffer, size_t len)
+{
+	(void) sinkdata;
+	return (fwrite(buffer, 1, len, stdout) == len && ! ferror(stdout)) ? 0 : -1;
+}
+
+static int
+stdoutLeader(void *sinkdata, int lineNumber)
+{
+	(void) sinkdata;
+	printLineLeader(lineNumber);
+	return 0;
 }
 
 /**
  * Process the given file, writing the the converted version on
- * standard output
+ * standard output, feeding the file to the converter a block at
+ * a time.
  *
- * Input characters should be transferred directly, except for the
- * following two cases:
- * - non-escaped actual newline characters in the input should cause
- *   the "line leader" to be printed out and the line number incremented
- * - any character following the escape character '\' may have a
- *   special meaing as follows:
- *      n : generate a "new line" character (with no "line leader")
- *      t : generate a tab character
- *      ' : generate a single quote character
- *     \n : (an actual newline character) in this case,
- *          generate nothing -- that is, the input should be as though
- *          this escaped end-of-line character never existed
- *      \ : (i.e.; the escape character itself) this should
- *          generate a '\' character
- *        : any other escaped character simply has it "unescaped" meaning,
- *          for example the sequence "\Q" would simply output a "Q"
+ * If writeIndex is set, a sidecar index is written next to the
+ * file as it is converted (see escindex.h).
  */
 static int
-convertLinesInFile(char *filename)
+convertLinesInFile(char *filename, int writeIndex)
 {
+	static char buffer[INPUT_BUFFER_SIZE];
+	EscSink sink = { stdoutWrite, stdoutLeader, NULL };
+	EscConverter conv;
+	EscIndexWriter indexWriter;
+	char *indexFilename = NULL;
 	FILE *ifp;
-	int c, lineNumber = 0, isInEscape = 0;
+	size_t nRead;
+	int status = 0;
 
 	ifp = fopen(filename, "r");
 	if (ifp == NULL) {
@@ -51,74 +91,619 @@ convertLinesInFile(char *filename)
 		return -1;
 	}
 
-	printLineLeader(++lineNumber);
+	if (writeIndex) {
+		indexFilename = escIndexFilename(filename);
+		if (indexFilename == NULL || escIndexWriterInit(&indexWriter, &conv,
+					&sink, fileno(ifp), indexFilename,
+					ESC_INDEX_DEFAULT_INTERVAL) < 0) {
+			fprintf(stderr, "Error: cannot create index '%s' : %s\n",
+					indexFilename ? indexFilename : filename, strerror(errno));
+			free(indexFilename);
+			fclose(ifp);
+			return -1;
+		}
+	} else {
+		escInit(&conv, &sink);
+	}
 
-	/** loop, reading one character at a time, until we get
+	/** loop, reading one block at a time, until we get
 	 * to the end of the file */
-	while ((c = getc(ifp)) != EOF) {
-		if (c == '\\' && !isInEscape) {
-			/** flag that we just saw an escape character */
-			isInEscape = 1;
-		} else {
+	while (status == 0 && (nRead = fread(buffer, 1, sizeof(buffer), ifp)) > 0) {
+		status = escFeed(&conv, buffer, nRead);
+	}
+	if (status == 0)
+		status = escFinish(&conv);
 
-			/**
-			 *  My code was added here for haneling escape characters
-			 */
-			if (isInEscape) {
-
-				//special cases for the escaped characters
-				if (c == 'n') //new line
-				{
-					putc(10, stdout);
-				} else if (c == 10) //if the char to escape its meaning is an actual new line char
-				{
-					//do nothing
-				} else if (c == 't') //if the char to escape its meaning is a tab char
-				{
-					//do a tab
-					putc('\t', stdout);
-				}
-				else {
-					putc(c, stdout);
-				}
+	if (writeIndex) {
+		if (escIndexWriterClose(&indexWriter, status) < 0 && status == 0) {
+			fprintf(stderr, "Error: cannot write index '%s' : %s\n",
+					indexFilename, strerror(errno));
+			status = -1;
+		}
+		free(indexFilename);
+	}
 
+	if (ferror(ifp) || status != 0) {
+		fprintf(stderr, "Error: cannot %s '%s' : %s\n",
+				ferror(ifp) ? "read" : "write output for",
+				filename, strerror(errno));
+		fclose(ifp);
+		return -1;
+	}
 
-				//now done escaping
-				isInEscape = 0;
+	printf("\n\nDONE\n");
 
-			} else if (c == 10) //check for an actually new line character
-			{
-				printLineLeader(++lineNumber);
-			} else {
-			
-				putc(c, stdout);
+	fclose(ifp);
+	return 0;
+}
+
+/**
+ * Print a single converted line of the given file, using the index
+ * written by an earlier conversion with "-x"
+ */
+static int
+printLineFromIndex(char *filename, int lineNumber)
+{
+	EscSink sink = { stdoutWrite, stdoutLeader, NULL };
+	char *indexFilename;
+	int status;
+
+	indexFilename = escIndexFilename(filename);
+	if (indexFilename == NULL) {
+		fprintf(stderr, "Error: out of memory\n");
+		return -1;
+	}
+
+	status = escSeekLine(filename, indexFilename, lineNumber, &sink);
+	if (status == ESC_SEEK_NO_SUCH_LINE) {
+		fprintf(stderr, "Error: '%s' has no line %d\n", filename, lineNumber);
+	} else if (status == ESC_SEEK_STALE_INDEX) {
+		fprintf(stderr, "Error: index '%s' is out of date -- "
+				"convert '%s' again with -x\n", indexFilename, filename);
+	} else if (status != 0) {
+		fprintf(stderr, "Error: cannot read '%s' : %s\n",
+				indexFilename, strerror(errno));
+	} else {
+		printf("\n");
+	}
+
+	free(indexFilename);
+	return (status == 0) ? 0 : -1;
+}
+
+
+
+/**
+ **		Parallel conversion
+ **
+ ** The escape state and the line number both carry over from one
+ ** character to the next, so a chunk in the middle of the file
+ ** cannot know either of them until everything before it is done.
+ **
+ ** Instead, each chunk is translated into memory without them:
+ ** - line leaders are only recorded as positions in the chunk
+ **   output; the numbers are filled in once the number of leaders
+ **   in all earlier chunks is known (a prefix sum)
+ ** - the chunk is translated for both possible starting escape
+ **   states.  The two translations can only differ over the leading
+ **   run of '\' characters and the one character after it, as any
+ **   other character leaves us out of an escape either way, so only
+ **   that short "head" is actually translated twice.
+ **/
+
+/** translated text for part of a chunk, with its line leader positions */
+typedef struct ChunkOutput {
+	char *text;
+	size_t len, cap;
+	size_t *leaderAt;
+	int nLeaders, leaderCap;
+} ChunkOutput;
+
+typedef struct ChunkJob {
+	const char *input;
+	size_t len;
+
+	/** the part of the chunk that depends on the starting state */
+	size_t headLen;
+	ChunkOutput head[2];
+	int headEndsInEscape[2];
+
+	/** the rest of the chunk, which always starts out of an escape */
+	ChunkOutput body;
+	int bodyEndsInEscape;
+
+	int failed;
+	int threadStarted;
+} ChunkJob;
+
+
+/** EscSink callbacks collecting a chunk in memory */
+static int
+chunkWrite(void *sinkdata, const char *buffer, size_t len)
+{
+	ChunkOutput *chunk = (ChunkOutput *) sinkdata;
+	char *newText;
+
+	if (chunk->len + len > chunk->cap) {
+		newText = (char *) realloc(chunk->text, (chunk->len + len) * 2);
+		if (newText == NULL)
+			return -1;
+		chunk->text = newText;
+		chunk->cap = (chunk->len + len) * 2;
+	}
+	memcpy(&chunk->text[chunk->len], buffer, len);
+	chunk->len += len;
+	return 0;
+}
+
+static int
+chunkLeader(void *sinkdata, int lineNumber)
+{
+	ChunkOutput *chunk = (ChunkOutput *) sinkdata;
+	size_t *newLeaderAt;
+	int newCap;
+
+	if (chunk->nLeaders == chunk->leaderCap) {
+		newCap = (chunk->leaderCap == 0) ? 64 : chunk->leaderCap * 2;
+		newLeaderAt = (size_t *) realloc(chunk->leaderAt,
+				newCap * sizeof(size_t));
+		if (newLeaderAt == NULL)
+			return -1;
+		chunk->leaderAt = newLeaderAt;
+		chunk->leaderCap = newCap;
+	}
+	chunk->leaderAt[chunk->nLeaders++] = chunk->len;
+	(void) lineNumber;
+	return 0;
+}
+
+/**
+ * Translate part of a chunk from the given starting escape state,
+ * setting the state it ends in.  Returns non-zero if we ran out
+ * of memory.
+ */
+static int
+translateIntoChunkOutput(ChunkOutput *chunk,
+		const char *buffer, size_t len, int isInEscape, int *endsInEscape)
+{
+	EscSink sink = { chunkWrite, chunkLeader, NULL };
+	EscConverter conv;
+	int status;
+
+	sink.sinkdata = chunk;
+	chunk->len = 0;
+	chunk->nLeaders = 0;
+
+	escResume(&conv, &sink, 0, isInEscape, 0);
+	status = escFeed(&conv, buffer, len);
+	*endsInEscape = conv.isInEscape;
+	return status;
+}
+
+static void
+freeChunkOutput(ChunkOutput *chunk)
+{
+	free(chunk->text);
+	free(chunk->leaderAt);
+	memset(chunk, 0, sizeof(ChunkOutput));
+}
+
+static void *
+translateChunkThread(void *vJob)
+{
+	ChunkJob *job = (ChunkJob *) vJob;
+	int s;
+
+	/** the head is the leading run of '\' plus one more character */
+	job->headLen = 0;
+	while (job->headLen < job->len && job->input[job->headLen] == '\\')
+		job->headLen++;
+	if (job->headLen < job->len)
+		job->headLen++;
+
+	job->failed = 0;
+	for (s = 0; s < 2; s++) {
+		job->failed |= translateIntoChunkOutput(&job->head[s],
+				job->input, job->headLen, s, &job->headEndsInEscape[s]);
+	}
+	job->failed |= translateIntoChunkOutput(&job->body,
+				&job->input[job->headLen], job->len - job->headLen, 0,
+				&job->bodyEndsInEscape);
+	return NULL;
+}
+
+/**
+ * Write out a translated part of a chunk, filling in the line
+ * numbers now that we know where this chunk starts.  Returns -1
+ * if the output could not be written, as stdoutWrite() does.
+ */
+static int
+writeChunkOutput(const ChunkOutput *chunk, int *lineNumber)
+{
+	size_t written = 0;
+	int i;
+
+	for (i = 0; i < chunk->nLeaders; i++) {
+		if (stdoutWrite(NULL, &chunk->text[written],
+					chunk->leaderAt[i] - written) < 0)
+			return -1;
+		written = chunk->leaderAt[i];
+		printLineLeader(++(*lineNumber));
+	}
+	return stdoutWrite(NULL, &chunk->text[written], chunk->len - written);
+}
+
+/**
+ * Process the given file as above, but translating chunks of it
+ * on nThreads threads at a time
+ */
+static int
+convertLinesInFileParallel(char *filename, int nThreads)
+{
+	ChunkJob jobs[MAX_THREADS];
+	pthread_t threads[MAX_THREADS];
+	struct stat sb;
+	const char *input;
+	size_t offset, chunkSize;
+	int fd, i, nJobs, s, isInEscape = 0, lineNumber = 0, status = 0;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "Error: cannot open '%s' : %s\n",
+				filename, strerror(errno));
+		return -1;
+	}
+
+	/** small files (and anything we cannot map) are not worth splitting */
+	if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode)
+			|| (size_t) sb.st_size <= PARALLEL_CHUNK_SIZE) {
+		close(fd);
+		return convertLinesInFile(filename, 0);
+	}
+
+	input = (const char *) mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (input == MAP_FAILED)
+		return convertLinesInFile(filename, 0);
+	madvise((void *) input, sb.st_size, MADV_SEQUENTIAL);
+
+	if (nThreads > MAX_THREADS)
+		nThreads = MAX_THREADS;
+	memset(jobs, 0, sizeof(jobs));
+
+	printLineLeader(++lineNumber);
+
+	/**
+	 * Each round translates up to nThreads chunks in parallel, then
+	 * stitches them together in order, so we never hold more than
+	 * nThreads chunks worth of output in memory at once
+	 */
+	for (offset = 0; offset < (size_t) sb.st_size && status == 0; ) {
+		for (nJobs = 0; nJobs < nThreads && offset < (size_t) sb.st_size; nJobs++) {
+			chunkSize = sb.st_size - offset;
+			if (chunkSize > PARALLEL_CHUNK_SIZE)
+				chunkSize = PARALLEL_CHUNK_SIZE;
+			jobs[nJobs].input = &input[offset];
+			jobs[nJobs].len = chunkSize;
+			offset += chunkSize;
+
+			jobs[nJobs].threadStarted = (pthread_create(&threads[nJobs],
+						NULL, translateChunkThread, &jobs[nJobs]) == 0);
+			if ( ! jobs[nJobs].threadStarted) {
+				/* no thread to be had -- do this one ourselves */
+				translateChunkThread(&jobs[nJobs]);
+			}
+		}
+
+		/** now pick the right head for each chunk, in order */
+		for (i = 0; i < nJobs; i++) {
+			if (jobs[i].threadStarted)
+				pthread_join(threads[i], NULL);
+			if (jobs[i].failed) {
+				fprintf(stderr, "Error: out of memory converting '%s'\n",
+						filename);
+				status = -1;
+			}
+			if (status == 0) {
+				s = isInEscape;
+				if (writeChunkOutput(&jobs[i].head[s], &lineNumber) < 0
+						|| writeChunkOutput(&jobs[i].body, &lineNumber) < 0) {
+					fprintf(stderr, "Error: cannot write output for '%s' : %s\n",
+							filename, strerror(errno));
+					status = -1;
+				}
+				isInEscape = (jobs[i].headLen < jobs[i].len)
+						? jobs[i].bodyEndsInEscape
+						: jobs[i].headEndsInEscape[s];
 			}
 		}
 	}
 
-	printf("\n\nDONE\n");
+	for (i = 0; i < MAX_THREADS; i++) {
+		freeChunkOutput(&jobs[i].head[0]);
+		freeChunkOutput(&jobs[i].head[1]);
+		freeChunkOutput(&jobs[i].body);
+	}
+	munmap((void *) input, sb.st_size);
 
+	if (status == 0)
+		printf("\n\nDONE\n");
+	return status;
+}
+
+/**
+ **		Batch conversion
+ **
+ ** Many files are converted at once on a pool of worker threads.
+ ** Each worker converts a whole file into memory, and the main
+ ** thread writes the results out in command line order, so the
+ ** output (and the point at which an error stops the run) is the
+ ** same as converting the files one after another.
+ **/
+
+/** how far the workers may get ahead of the output, per worker */
+#define	BATCH_LOOKAHEAD		2
+
+#define	BATCH_ERROR_SIZE	512
+
+typedef struct BatchJob {
+	char *filename;
+	ChunkOutput output;
+	char errorMessage[BATCH_ERROR_SIZE];
+	int status;
+	int done;
+} BatchJob;
+
+typedef struct BatchQueue {
+	BatchJob *jobs;
+	int nJobs;
+	int nextJob;		/* the next job for a worker to pick up */
+	int nWritten;		/* how many jobs have been written out */
+	int maxAhead;
+	int cancelled;
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+} BatchQueue;
+
+
+/**
+ * Convert one file into the job's output, keeping any error
+ * message to be printed when the job's turn comes
+ */
+static void
+convertBatchJob(BatchJob *job, char *buffer, size_t bufsize)
+{
+	EscSink sink = { chunkWrite, NULL, NULL };
+	EscConverter conv;
+	FILE *ifp;
+	size_t nRead;
+	int status = 0;
+
+	ifp = fopen(job->filename, "r");
+	if (ifp == NULL) {
+		snprintf(job->errorMessage, BATCH_ERROR_SIZE,
+				"Error: cannot open '%s' : %s\n",
+				job->filename, strerror(errno));
+		job->status = -1;
+		return;
+	}
+
+	sink.sinkdata = &job->output;
+	escInit(&conv, &sink);
+	while (status == 0 && (nRead = fread(buffer, 1, bufsize, ifp)) > 0) {
+		status = escFeed(&conv, buffer, nRead);
+	}
+	if (status == 0)
+		status = escFinish(&conv);
+
+	if (ferror(ifp) || status != 0) {
+		snprintf(job->errorMessage, BATCH_ERROR_SIZE,
+				"Error: cannot %s '%s' : %s\n",
+				ferror(ifp) ? "read" : "convert in memory",
+				job->filename, strerror(ferror(ifp) ? errno : ENOMEM));
+		job->status = -1;
+	}
 	fclose(ifp);
-	return 0;
+}
+
+static void *
+batchWorkerThread(void *vQueue)
+{
+	BatchQueue *queue = (BatchQueue *) vQueue;
+	char *buffer;
+	int which;
+
+	buffer = (char *) malloc(INPUT_BUFFER_SIZE);
+
+	pthread_mutex_lock(&queue->lock);
+	for (;;) {
+		while ( ! queue->cancelled && queue->nextJob < queue->nJobs
+				&& queue->nextJob >= queue->nWritten + queue->maxAhead)
+			pthread_cond_wait(&queue->changed, &queue->lock);
+		if (queue->cancelled || queue->nextJob >= queue->nJobs)
+			break;
+		which = queue->nextJob++;
+		pthread_mutex_unlock(&queue->lock);
+
+		if (buffer == NULL) {
+			snprintf(queue->jobs[which].errorMessage, BATCH_ERROR_SIZE,
+					"Error: out of memory\n");
+			queue->jobs[which].status = -1;
+		} else {
+			convertBatchJob(&queue->jobs[which], buffer, INPUT_BUFFER_SIZE);
+		}
+
+		pthread_mutex_lock(&queue->lock);
+		queue->jobs[which].done = 1;
+		pthread_cond_broadcast(&queue->changed);
+	}
+	pthread_mutex_unlock(&queue->lock);
+
+	free(buffer);
+	return NULL;
+}
+
+/**
+ * Convert all of the given files using nWorkers threads, writing
+ * them out in the order given.  Returns -1 as soon as one fails,
+ * after reporting it.
+ */
+static int
+convertFilesInBatch(char **filenames, int nFiles, int nWorkers)
+{
+	pthread_t threads[MAX_THREADS];
+	BatchQueue queue;
+	BatchJob *job;
+	int i, nStarted, status = 0;
+
+	if (nWorkers > MAX_THREADS)
+		nWorkers = MAX_THREADS;
+
+	memset(&queue, 0, sizeof(queue));
+	queue.jobs = (BatchJob *) calloc(nFiles, sizeof(BatchJob));
+	if (queue.jobs == NULL) {
+		fprintf(stderr, "Error: out of memory\n");
+		return -1;
+	}
+	for (i = 0; i < nFiles; i++)
+		queue.jobs[i].filename = filenames[i];
+	queue.nJobs = nFiles;
+	queue.maxAhead = nWorkers * BATCH_LOOKAHEAD;
+	pthread_mutex_init(&queue.lock, NULL);
+	pthread_cond_init(&queue.changed, NULL);
+
+	for (nStarted = 0; nStarted < nWorkers; nStarted++) {
+		if (pthread_create(&threads[nStarted], NULL,
+					batchWorkerThread, &queue) != 0)
+			break;
+	}
+	if (nStarted == 0) {
+		/* no threads to be had -- fall back to doing it all here */
+		queue.maxAhead = nFiles;
+		batchWorkerThread(&queue);
+	}
+
+	for (i = 0; i < nFiles && status == 0; i++) {
+		job = &queue.jobs[i];
+
+		pthread_mutex_lock(&queue.lock);
+		while ( ! job->done)
+			pthread_cond_wait(&queue.changed, &queue.lock);
+		pthread_mutex_unlock(&queue.lock);
+
+		if (job->status < 0) {
+			fputs(job->errorMessage, stderr);
+			fprintf(stderr, "Error: conversion of '%s' failed\n", job->filename);
+			status = -1;
+		} else if (stdoutWrite(NULL, job->output.text, job->output.len) < 0) {
+			fprintf(stderr, "Error: cannot write output for '%s' : %s\n",
+					job->filename, strerror(errno));
+			status = -1;
+		} else {
+			printf("\n\nDONE\n");
+		}
+		freeChunkOutput(&job->output);
+
+		pthread_mutex_lock(&queue.lock);
+		queue.nWritten = i + 1;
+		if (status < 0)
+			queue.cancelled = 1;
+		pthread_cond_broadcast(&queue.changed);
+		pthread_mutex_unlock(&queue.lock);
+	}
+
+	for (i = 0; i < nStarted; i++)
+		pthread_join(threads[i], NULL);
+
+	/** anything converted after a failure is simply thrown away */
+	for (i = 0; i < nFiles; i++)
+		freeChunkOutput(&queue.jobs[i].output);
+	pthread_cond_destroy(&queue.changed);
+	pthread_mutex_destroy(&queue.lock);
+	free(queue.jobs);
+	return status;
 }
 
 /**
  * Program mainline
+ *
+ * Flags apply to the files that follow them on the command line:
+ *   -P <n> : convert in parallel using n threads
+ *   -x     : write a sidecar index next to each file as it is
+ *            converted (this is done serially, even with -P)
+ *   -l <n> : rather than converting, print only line n of each
+ *            file, using the index written by -x
+ *   -j <n> : convert the files on n worker threads at once, still
+ *            writing them out in order (ignored with -x or -l)
  */
 int
 main(int argc, char **argv)
 {
-	int i;
+	int i, nThreads = 1, writeIndex = 0, lineToPrint = 0, status = 0;
+	int nWorkers = 1, nBatch = 0;
+	char **batch;
+
+	stdoutIsTerminal = isatty(fileno(stdout));
 
-	for (i = 1; i < argc; i++) {
+	/** files to be converted in a batch are gathered up here */
+	batch = (char **) malloc(argc * sizeof(char *));
+	if (batch == NULL) {
+		fprintf(stderr, "Error: out of memory\n");
+		return -1;
+	}
+
+	for (i = 1; i < argc && status == 0; i++) {
 		if (argv[i][0] == '-') {
-			fprintf(stderr, "Error: unknown flag '%s'\n", argv[i]);
-			return -1;
-		} else if (convertLinesInFile(argv[i]) < 0) {
-			fprintf(stderr, "Error: conversion of '%s' failed\n", argv[i]);
-			return -1;
+			/** a flag ends the batch of files before it */
+			if (nBatch > 0) {
+				status = convertFilesInBatch(batch, nBatch, nWorkers);
+				nBatch = 0;
+				if (status < 0)
+					break;
+			}
+
+			if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+				nWorkers = atoi(argv[++i]);
+				if (nWorkers < 1) {
+					fprintf(stderr, "Error: bad worker count '%s'\n", argv[i]);
+					status = -1;
+				}
+			} else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+				nThreads = atoi(argv[++i]);
+				if (nThreads < 1) {
+					fprintf(stderr, "Error: bad thread count '%s'\n", argv[i]);
+					status = -1;
+				}
+			} else if (strcmp(argv[i], "-x") == 0) {
+				writeIndex = 1;
+			} else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+				lineToPrint = atoi(argv[++i]);
+				if (lineToPrint < 1) {
+					fprintf(stderr, "Error: bad line number '%s'\n", argv[i]);
+					status = -1;
+				}
+			} else {
+				fprintf(stderr, "Error: unknown flag '%s'\n", argv[i]);
+				status = -1;
+			}
+		} else if (lineToPrint > 0) {
+			status = printLineFromIndex(argv[i], lineToPrint);
+		} else if (nWorkers > 1 && ! writeIndex) {
+			batch[nBatch++] = argv[i];
+		} else {
+			if (nThreads > 1 && ! writeIndex)
+				status = convertLinesInFileParallel(argv[i], nThreads);
+			else
+				status = convertLinesInFile(argv[i], writeIndex);
+
+			if (status < 0)
+				fprintf(stderr, "Error: conversion of '%s' failed\n", argv[i]);
 		}
 	}
-	return 0;
-}
 
+	if (status == 0 && nBatch > 0)
+		status = convertFilesInBatch(batch, nBatch, nWorkers);
+
+	free(batch);
+	return (status < 0) ? -1 : 0;
+}
@@ -4,6 +4,14 @@
 #include <errno.h>	/* for errno */
 
 #include "LLGeneric.h"	/* include our macros and prototypes */
+#include "LLInstrument.h"	/* counters, if LST_INSTRUMENT is defined */
+
+/** ask for memory to be brought into cache ahead of when we need it */
+#if defined(__GNUC__)
+#define	LST_PREFETCH(address)	__builtin_prefetch(address)
+#else
+#define	LST_PREFETCH(address)	((void) (address))
+#endif
 
 
 /**
@@ -24,12 +32,71 @@ lstPerformIterativeAction(
 	curNode = list;
 	nodeCount = 0;
 
+	LST_COUNT(nIterateCalls, 1);
+
 	while (curNode != NULL) {
 		status = (*action)(curNode, nodeCount++, userdata);
-		if (status < 0)	return status;
+		if (status < 0) {
+			LST_COUNT(nIterateHops, nodeCount);
+			return status;
+		}
 		curNode = curNode->next;
 	}
 
+	LST_COUNT(nIterateHops, nodeCount);
+	LST_COUNT_LENGTH(nodeCount);
+	return nodeCount;
+}
+
+
+/**
+ * Process this list a batch of nodes at a time, returning the number
+ * of nodes processed, or a negative value on error
+ *
+ * Up to batchSize node pointers are collected, prefetching each
+ * node's payload as we go, and then handed to the action in one
+ * call along with the index of the first of them.  While we are
+ * still chasing next pointers through the batch, the payloads of the
+ * nodes already found are on their way into cache, so the misses
+ * overlap instead of each one stalling the loop in turn.  Calling
+ * the action once per batch also lets it run a tight loop of its own.
+ */
+int
+lstPerformBatchedAction(
+		GenericListNode *list,
+		int batchSize,
+		int (*action)(GenericListNode **, int, int, void *),
+		void *userdata
+	)
+{
+	GenericListNode *batch[LST_MAX_BATCH_SIZE];
+	GenericListNode *curNode = NULL;
+	int nodeCount, nInBatch, status;
+
+	if (batchSize < 1)
+		batchSize = 1;
+	if (batchSize > LST_MAX_BATCH_SIZE)
+		batchSize = LST_MAX_BATCH_SIZE;
+
+	curNode = list;
+	nodeCount = 0;
+
+	LST_COUNT(nIterateCalls, 1);
+
+	while (curNode != NULL) {
+		for (nInBatch = 0; nInBatch < batchSize && curNode != NULL; nInBatch++) {
+			LST_PREFETCH(curNode->data);
+			batch[nInBatch] = curNode;
+			curNode = curNode->next;
+		}
+
+		status = (*action)(batch, nInBatch, nodeCount, userdata);
+		LST_COUNT(nIterateHops, nInBatch);
+		if (status < 0)	return status;
+		nodeCount += nInBatch;
+	}
+
+	LST_COUNT_LENGTH(nodeCount);
 	return nodeCount;
 }
 
@@ -44,6 +111,8 @@ lstCreateNode(void * const userdata)
 	GenericListNode *newNode = NULL;
 
 	newNode = (GenericListNode *) malloc(sizeof(GenericListNode));
+	LST_COUNT(nNodesCreated, 1);
+	LST_COUNT(bytesOutstanding, sizeof(GenericListNode));
 	newNode->next = NULL;
 	newNode->data = userdata;
 	return newNode;
@@ -66,6 +135,8 @@ lstDestroyList(
 		nextNode = curNode->next;
 		(*useraction)(curNode, userdata);
 		free(curNode);
+		LST_COUNT(nNodesDestroyed, 1);
+		LST_COUNT(bytesOutstanding, -(long long) sizeof(GenericListNode));
 		curNode = nextNode;
 	}
 }
@@ -81,12 +152,17 @@ GenericListNode *
 lstAppend(GenericListNode *listp, GenericListNode *newp)
 {
 	GenericListNode *p;
+	LST_LOCAL_COUNTER(nHops);
+
+	LST_COUNT(nAppendCalls, 1);
 
 	if (listp == NULL)
 		return newp;
 
 	for (p = listp; p->next; p = p->next)
-		;
+		LST_LOCAL_INCREMENT(nHops);
+	LST_COUNT(nAppendHops, nHops);
+	LST_COUNT_LENGTH(nHops + 2);
 
 	p->next = newp;
 	return listp;
@@ -107,3 +183,253 @@ lstPrepend(GenericListNode *listp, GenericListNode *newp)
 }
 
 
+
+
+/*
+ * lstInitList: set up an empty list handle
+ */
+void
+lstInitList(GenericList *list)
+{
+	list->head = NULL;
+	list->tail = NULL;
+	list->count = 0;
+	list->nSkip = 0;
+	list->skipStride = 1;
+	list->skipCountdown = 0;
+	list->skipStale = 0;
+}
+
+
+/*
+ * Note newp, which has just gone onto the end of list, in skip[]
+ * if it falls on the stride.  Once skip[] is full every second
+ * entry is dropped and the stride doubled, so the entries always
+ * stay evenly spaced, and there is never anything to allocate.
+ */
+static void
+lstListRecordSkip(GenericList *list, GenericListNode *newp)
+{
+	int i;
+
+	if (list->skipCountdown == 0) {
+		if (list->nSkip == LST_LIST_SKIP_SLOTS) {
+			for (i = 1; i < LST_LIST_SKIP_SLOTS / 2; i++)
+				list->skip[i] = list->skip[i * 2];
+			list->nSkip = LST_LIST_SKIP_SLOTS / 2;
+			list->skipStride *= 2;
+		}
+		list->skip[list->nSkip++] = newp;
+		list->skipCountdown = list->skipStride;
+	}
+	list->skipCountdown--;
+}
+
+
+/*
+ * lstListAppend: add newp to end of list
+ *
+ * unlike lstAppend() there is no walk to find the end, as
+ * the handle already knows where it is
+ */
+void
+lstListAppend(GenericList *list, GenericListNode *newp)
+{
+	newp->next = NULL;
+	if (list->tail == NULL)
+		list->head = newp;
+	else
+		list->tail->next = newp;
+	list->tail = newp;
+	list->count++;
+	LST_COUNT_LENGTH(list->count);
+
+	if ( ! list->skipStale)
+		lstListRecordSkip(list, newp);
+}
+
+
+/*
+ * lstListPrepend: add newp to front of list
+ */
+void
+lstListPrepend(GenericList *list, GenericListNode *newp)
+{
+	newp->next = list->head;
+	list->head = newp;
+	if (list->tail == NULL)
+		list->tail = newp;
+	list->count++;
+	LST_COUNT_LENGTH(list->count);
+
+	/** every node already in skip[] has moved along by one */
+	if (list->count > 1)
+		list->skipStale = 1;
+	else if ( ! list->skipStale)
+		lstListRecordSkip(list, newp);
+}
+
+
+/*
+ * lstListLength: the number of nodes in list
+ */
+int
+lstListLength(const GenericList *list)
+{
+	return list->count;
+}
+
+
+/*
+ * lstListSplice: move all of the nodes in other onto the end of
+ * list, leaving other empty
+ */
+void
+lstListSplice(GenericList *list, GenericList *other)
+{
+	if (other->head == NULL)
+		return;
+
+	if (list->tail == NULL)
+		list->head = other->head;
+	else
+		list->tail->next = other->head;
+	list->tail = other->tail;
+	list->count += other->count;
+	LST_COUNT_LENGTH(list->count);
+	list->skipStale = 1;
+
+	lstInitList(other);
+}
+
+
+/*
+ * Bottom-up merge sort of a list, relinking the nodes rather than
+ * moving any data, so no memory is allocated and the only extra
+ * space is a few local variables.
+ *
+ * Each pass walks the list merging neighbouring sorted runs of
+ * runSize nodes into runs of twice that, until a pass does only a
+ * single merge.  Taking from the left run whenever the comparator
+ * says the two are equal keeps the sort stable.
+ *
+ * The comparator is given the data pointers of two nodes, and
+ * returns <0, 0 or >0 just as for qsort().
+ */
+static GenericListNode *
+lstSortReturningTail(
+		GenericListNode *list,
+		int (*comparator)(const void *, const void *),
+		GenericListNode **tailp
+	)
+{
+	GenericListNode *left, *right, *next, *tail;
+	long runSize, nMerges, leftSize, rightSize, i;
+
+	*tailp = NULL;
+	if (list == NULL)
+		return NULL;
+
+	for (runSize = 1; ; runSize *= 2) {
+		left = list;
+		list = NULL;
+		tail = NULL;
+		nMerges = 0;
+
+		while (left != NULL) {
+			nMerges++;
+
+			/** the right run starts runSize nodes along (if there is one) */
+			right = left;
+			leftSize = 0;
+			for (i = 0; i < runSize && right != NULL; i++) {
+				leftSize++;
+				right = right->next;
+			}
+			rightSize = runSize;
+
+			/** merge the two runs onto the end of the new list */
+			while (leftSize > 0 || (rightSize > 0 && right != NULL)) {
+				if (leftSize == 0) {
+					next = right;
+					right = right->next;
+					rightSize--;
+				} else if (rightSize == 0 || right == NULL
+						|| (*comparator)(left->data, right->data) <= 0) {
+					next = left;
+					left = left->next;
+					leftSize--;
+				} else {
+					next = right;
+					right = right->next;
+					rightSize--;
+				}
+
+				if (tail == NULL)
+					list = next;
+				else
+					tail->next = next;
+				tail = next;
+			}
+
+			left = right;
+		}
+		tail->next = NULL;
+
+		if (nMerges <= 1) {
+			*tailp = tail;
+			return list;
+		}
+	}
+}
+
+
+/*
+ * lstSort: sort the list, returning the value that
+ * should be the new head of the list
+ */
+GenericListNode *
+lstSort(
+		GenericListNode *list,
+		int (*comparator)(const void *, const void *)
+	)
+{
+	GenericListNode *tail;
+
+	return lstSortReturningTail(list, comparator, &tail);
+}
+
+
+/*
+ * lstListSort: sort the list held by a handle
+ */
+void
+lstListSort(
+		GenericList *list,
+		int (*comparator)(const void *, const void *)
+	)
+{
+	list->head = lstSortReturningTail(list->head, comparator, &list->tail);
+	list->skipStale = 1;
+}
+
+
+/*
+ * lstListRefreshSkips: if nodes have been moved about since skip[]
+ * was last right, build it again with one walk along the list
+ */
+void
+lstListRefreshSkips(GenericList *list)
+{
+	GenericListNode *curNode;
+
+	if ( ! list->skipStale)
+		return;
+
+	list->nSkip = 0;
+	list->skipStride = 1;
+	list->skipCountdown = 0;
+	list->skipStale = 0;
+	for (curNode = list->head; curNode != NULL; curNode = curNode->next)
+		lstListRecordSkip(list, curNode);
+}
@@ -14,6 +14,37 @@ typedef struct GenericListNode {
 	void *data;
 } GenericListNode;
 
+/** how many evenly spaced nodes a list handle remembers */
+#define	LST_LIST_SKIP_SLOTS	64
+
+/**
+ * A handle on a whole list.  Keeping track of the tail and the
+ * number of nodes lets us add at either end, find the length and
+ * join lists together without walking along them.
+ *
+ * The handle also remembers every skipStride'th node in skip[], so
+ * that a list can be cut into segments (see LLParallel.h) without a
+ * walk.  Appending keeps skip[] up to date; operations that move
+ * nodes around only set skipStale, and lstListRefreshSkips() builds
+ * it again when it is next wanted.
+ *
+ * The nodes themselves are the same as above, so "head" can be
+ * handed to any of the node level functions below.
+ */
+typedef struct GenericList {
+	GenericListNode *head;
+	GenericListNode *tail;
+	int count;
+	GenericListNode *skip[LST_LIST_SKIP_SLOTS];
+	int nSkip;
+	int skipStride;
+	int skipCountdown;
+	int skipStale;
+} GenericList;
+
+/** the most nodes lstPerformBatchedAction() will hand over at once */
+#define	LST_MAX_BATCH_SIZE	64
+
 /**
  ** FUNCTION PROTOTYPES
  **/
@@ -33,11 +64,48 @@ int lstPerformIterativeAction(
 		void *userdata
 	);
 
+int lstPerformBatchedAction(
+		GenericListNode *list,
+		int batchSize,
+		int (*action)(GenericListNode **, int, int, void *),
+		void *userdata
+	);
+
 /* lstPrepend: add newp to front of list */
 GenericListNode *lstPrepend(GenericListNode *listp, GenericListNode *newp);
 
 /* lstAppend: add newp to end of listp */
 GenericListNode *lstAppend(GenericListNode *listp, GenericListNode *newp);
 
+/* lstInitList: set up an empty list handle */
+void lstInitList(GenericList *list);
+
+/* lstListAppend: add newp to end of list in constant time */
+void lstListAppend(GenericList *list, GenericListNode *newp);
+
+/* lstListPrepend: add newp to front of list in constant time */
+void lstListPrepend(GenericList *list, GenericListNode *newp);
+
+/* lstListLength: the number of nodes in list */
+int lstListLength(const GenericList *list);
+
+/* lstListSplice: move all of the nodes in other onto the end of list */
+void lstListSplice(GenericList *list, GenericList *other);
+
+/* lstSort: stable sort of the nodes by their data, returning the new head */
+GenericListNode *lstSort(
+		GenericListNode *list,
+		int (*comparator)(const void *, const void *)
+	);
+
+/* lstListSort: as lstSort(), keeping the list handle up to date */
+void lstListSort(
+		GenericList *list,
+		int (*comparator)(const void *, const void *)
+	);
+
+/* lstListRefreshSkips: rebuild the handle's skip[] if it is stale */
+void lstListRefreshSkips(GenericList *list);
+
 
 #endif /* __GENERIC_LINKED_LIST_HEADER__ */
@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h> /* for atexit() */
+#include <string.h> /* for memset() */
+
+#include "LLInstrument.h"	/* include our macros and prototypes */
+
+#ifdef LST_INSTRUMENT
+LstInstrumentStats lstInstrumentCounters;
+#endif
+
+
+void
+lstInstrumentGetStats(LstInstrumentStats *stats)
+{
+#ifdef LST_INSTRUMENT
+	unsigned long long *from = (unsigned long long *) &lstInstrumentCounters;
+	unsigned long long *into = (unsigned long long *) stats;
+	size_t i;
+
+	/** every field is 64 bits, so read them one at a time atomically */
+	for (i = 0; i < sizeof(LstInstrumentStats) / sizeof(*from); i++)
+		into[i] = __atomic_load_n(&from[i], __ATOMIC_RELAXED);
+#else
+	memset(stats, 0, sizeof(LstInstrumentStats));
+#endif
+}
+
+void
+lstInstrumentReset(void)
+{
+#ifdef LST_INSTRUMENT
+	unsigned long long *counters = (unsigned long long *) &lstInstrumentCounters;
+	size_t i;
+
+	for (i = 0; i < sizeof(LstInstrumentStats) / sizeof(*counters); i++)
+		__atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+#endif
+}
+
+#ifdef LST_INSTRUMENT
+/** the average of total over n calls, without dividing by zero */
+static double
+perCall(unsigned long long total, unsigned long long n)
+{
+	return (n == 0) ? 0.0 : (double) total / (double) n;
+}
+#endif
+
+void
+lstInstrumentDump(FILE *ofp)
+{
+#ifdef LST_INSTRUMENT
+	LstInstrumentStats stats;
+
+	lstInstrumentGetStats(&stats);
+	fprintf(ofp, "List instrumentation:\n");
+	fprintf(ofp, "  nodes created     : %llu\n", stats.nNodesCreated);
+	fprintf(ofp, "  nodes destroyed   : %llu\n", stats.nNodesDestroyed);
+	fprintf(ofp, "  bytes outstanding : %lld\n", stats.bytesOutstanding);
+	fprintf(ofp, "  bytes in slabs    : %llu\n", stats.bytesInSlabs);
+	fprintf(ofp, "  lstAppend calls   : %llu (%.1f hops each)\n",
+			stats.nAppendCalls, perCall(stats.nAppendHops, stats.nAppendCalls));
+	fprintf(ofp, "  iterations        : %llu (%.1f hops each)\n",
+			stats.nIterateCalls, perCall(stats.nIterateHops, stats.nIterateCalls));
+	fprintf(ofp, "  longest list      : %llu\n", stats.maxListLength);
+#else
+	fprintf(ofp, "List instrumentation not compiled in (define LST_INSTRUMENT)\n");
+#endif
+}
+
+static void
+lstInstrumentDumpToStderr(void)
+{
+	lstInstrumentDump(stderr);
+}
+
+/**
+ * Returns 0 if the dump has been arranged (or there is nothing
+ * to dump), and -1 if atexit() has no room for it
+ */
+int
+lstInstrumentDumpAtExit(void)
+{
+#ifdef LST_INSTRUMENT
+	static int registered = 0;
+
+	if ( ! registered) {
+		if (atexit(lstInstrumentDumpToStderr) != 0)
+			return -1;
+		registered = 1;
+	}
+#else
+	(void) lstInstrumentDumpToStderr;
+#endif
+	return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * Header file for the optional instrumentation of the generic lists.
+ *
+ * When the library is compiled with LST_INSTRUMENT defined, the list
+ * and node pool functions count how many nodes they create and
+ * destroy, how much node memory is in use, how many next pointers
+ * lstAppend() and the iterators follow, and the longest list seen.
+ * This tells us whether a program spends its time allocating or
+ * chasing pointers.
+ *
+ * Without LST_INSTRUMENT the counting macros expand to nothing, so
+ * the lists run exactly as before; the query functions are still
+ * there (reporting all zeroes) so that callers need no #ifdefs.
+ *
+ * The counters are updated with relaxed atomic operations, as the
+ * node pools and iterators may be used from several threads.
+ */
+
+#ifndef __GENERIC_LIST_INSTRUMENT_HEADER__
+#define __GENERIC_LIST_INSTRUMENT_HEADER__
+
+#include <stdio.h>
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct LstInstrumentStats {
+	unsigned long long nNodesCreated;
+	unsigned long long nNodesDestroyed;
+	long long bytesOutstanding;			/* in nodes still in use */
+	unsigned long long bytesInSlabs;	/* allocated by node pools */
+
+	unsigned long long nAppendCalls;	/* lstAppend() only */
+	unsigned long long nAppendHops;
+	unsigned long long nIterateCalls;	/* lstPerform*Action() */
+	unsigned long long nIterateHops;
+
+	unsigned long long maxListLength;
+} LstInstrumentStats;
+
+#ifdef LST_INSTRUMENT
+
+extern LstInstrumentStats lstInstrumentCounters;
+
+#define	LST_COUNT(field, n) \
+		((void) __atomic_add_fetch(&lstInstrumentCounters.field, \
+				(n), __ATOMIC_RELAXED))
+
+#define	LST_COUNT_LENGTH(length) \
+		lstInstrumentNoteLength((unsigned long long) (length))
+
+/** a count kept in a local variable, to be added in with LST_COUNT() */
+#define	LST_LOCAL_COUNTER(name)		unsigned long long name = 0
+#define	LST_LOCAL_INCREMENT(name)	((void) (name)++)
+
+/** keep track of the longest list we have seen */
+static inline void
+lstInstrumentNoteLength(unsigned long long length)
+{
+	unsigned long long max = __atomic_load_n(
+			&lstInstrumentCounters.maxListLength, __ATOMIC_RELAXED);
+
+	while (length > max && ! __atomic_compare_exchange_n(
+				&lstInstrumentCounters.maxListLength, &max, length,
+				1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+#else
+
+#define	LST_COUNT(field, n)			((void) 0)
+#define	LST_COUNT_LENGTH(length)	((void) 0)
+#define	LST_LOCAL_COUNTER(name)
+#define	LST_LOCAL_INCREMENT(name)	((void) 0)
+
+#endif /* LST_INSTRUMENT */
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* copy the counters so far into stats */
+void lstInstrumentGetStats(LstInstrumentStats *stats);
+
+/* set all of the counters back to zero */
+void lstInstrumentReset(void);
+
+/* print the counters in a readable form */
+void lstInstrumentDump(FILE *ofp);
+
+/* arrange for the counters to be printed on stderr when the program exits */
+int lstInstrumentDumpAtExit(void);
+
+#endif /* __GENERIC_LIST_INSTRUMENT_HEADER__ */
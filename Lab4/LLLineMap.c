@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+#include <string.h> /* for memcpy() */
+#include <fcntl.h>	/* for open() */
+#include <unistd.h>	/* for close() */
+#include <sys/mman.h>	/* for mmap() */
+#include <sys/stat.h>	/* for fstat() */
+
+#include "LLLineMap.h"	/* include our macros and prototypes */
+#include "LLLineScan.h"
+
+/** how many lines we make room for at first */
+#define	LINEMAP_INITIAL_LINES	1024
+
+
+/**
+ * Make room for more lines.  The arrays are doubled, so there are
+ * only O(log n) of these for the whole file.
+ */
+static int
+lineMapGrow(LineMap *map, int *capacity)
+{
+	size_t *newOffsets;
+	unsigned int *newLengths;
+	int newCapacity = (*capacity == 0) ? LINEMAP_INITIAL_LINES : *capacity * 2;
+
+	newOffsets = (size_t *) realloc(map->offsets, newCapacity * sizeof(size_t));
+	if (newOffsets == NULL)
+		return -1;
+	map->offsets = newOffsets;
+
+	newLengths = (unsigned int *) realloc(map->lengths,
+			newCapacity * sizeof(unsigned int));
+	if (newLengths == NULL)
+		return -1;
+	map->lengths = newLengths;
+
+	*capacity = newCapacity;
+	return 0;
+}
+
+/**
+ * Map the file into memory and make one pass over it to find where
+ * each line starts, using the vectorized newline scanner
+ */
+int
+lstLineMapLoad(LineMap *map, const char *filename)
+{
+	struct stat sb;
+	size_t pos, end;
+	int fd, capacity = 0;
+
+	memset(map, 0, sizeof(LineMap));
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &sb) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	/** an empty file has no lines -- and cannot be mapped */
+	if (sb.st_size == 0) {
+		close(fd);
+		return 0;
+	}
+
+	map->size = sb.st_size;
+	map->text = (const char *) mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map->text == MAP_FAILED) {
+		map->text = NULL;
+		return -1;
+	}
+	madvise((void *) map->text, map->size, MADV_SEQUENTIAL);
+
+	for (pos = 0; pos < map->size; pos = end) {
+		end = pos + lstFindNewline(&map->text[pos], map->size - pos);
+		if (end < map->size)
+			end++;	/* keep the newline, as fgets() does */
+
+		if (map->nLines == capacity && lineMapGrow(map, &capacity) < 0) {
+			lstLineMapDestroy(map);
+			return -1;
+		}
+		map->offsets[map->nLines] = pos;
+		map->lengths[map->nLines] = (unsigned int) (end - pos);
+		map->nLines++;
+	}
+
+	return 0;
+}
+
+/**
+ * Copy a line out into a string of its own the first time it is
+ * asked for; the same string is handed back after that
+ */
+const char *
+lstLineMapGetString(LineMap *map, int index)
+{
+	char *string;
+
+	if (index < 0 || index >= map->nLines)
+		return NULL;
+
+	if (map->strings == NULL) {
+		map->strings = (char **) calloc(map->nLines, sizeof(char *));
+		if (map->strings == NULL)
+			return NULL;
+	}
+
+	if (map->strings[index] == NULL) {
+		string = (char *) malloc(map->lengths[index] + 1);
+		if (string == NULL)
+			return NULL;
+		memcpy(string, &map->text[map->offsets[index]], map->lengths[index]);
+		string[map->lengths[index]] = '\0';
+		map->strings[index] = string;
+	}
+	return map->strings[index];
+}
+
+int
+lstLineMapLength(const LineMap *map)
+{
+	return map->nLines;
+}
+
+
+/**
+ * Process each line using the user's supplied function and data,
+ * returning the number of lines processed, or a negative value
+ * on error
+ *
+ * The node handed to the callback has a LineMapLine as its data
+ * (and a NULL next), so no string is made unless the callback
+ * asks for one.
+ */
+int
+lstLineMapPerformIterativeAction(
+		LineMap *map,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	)
+{
+	GenericListNode lineNode;
+	LineMapLine line;
+	int status;
+
+	lineNode.next = NULL;
+	lineNode.data = &line;
+	line.map = map;
+
+	for (line.index = 0; line.index < map->nLines; line.index++) {
+		line.start = &map->text[map->offsets[line.index]];
+		line.length = map->lengths[line.index];
+		status = (*action)(&lineNode, line.index, userdata);
+		if (status < 0)	return status;
+	}
+
+	return map->nLines;
+}
+
+void
+lstLineMapDestroy(LineMap *map)
+{
+	int i;
+
+	if (map->strings != NULL) {
+		for (i = 0; i < map->nLines; i++)
+			free(map->strings[i]);
+		free(map->strings);
+	}
+	free(map->offsets);
+	free(map->lengths);
+	if (map->text != NULL)
+		munmap((void *) map->text, map->size);
+
+	memset(map, 0, sizeof(LineMap));
+}
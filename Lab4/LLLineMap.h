@@ -0,0 +1,64 @@
+/**
+ * Header file for a memory mapped "list" of the lines in a file.
+ *
+ * Rather than copying every line into its own allocated string, the
+ * file is mapped into memory and only the offset and length of each
+ * line are kept, in two compact arrays.  A line is copied out into a
+ * string of its own only if someone asks for it.
+ */
+
+#ifndef __LINE_MAP_HEADER__
+#define __LINE_MAP_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+#include "LLGeneric.h"
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct LineMap {
+	const char *text;			/* the mapped file */
+	size_t size;
+	size_t *offsets;			/* where each line starts in text */
+	unsigned int *lengths;		/* each line's length, with its newline */
+	int nLines;
+	char **strings;				/* lines copied out so far, or NULL */
+} LineMap;
+
+/**
+ * What the iteration callback gets as its node's data -- a reference
+ * to the line, which can be used as is (it is NOT nul terminated)
+ * or turned into a string with lstLineMapGetString()
+ */
+typedef struct LineMapLine {
+	LineMap *map;
+	int index;
+	const char *start;
+	size_t length;
+} LineMapLine;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* map the file and find its lines, returning -1 on failure */
+int lstLineMapLoad(LineMap *map, const char *filename);
+
+/* the line as a string (with its newline, as fgets() gives it), or NULL */
+const char *lstLineMapGetString(LineMap *map, int index);
+
+/* the number of lines */
+int lstLineMapLength(const LineMap *map);
+
+int lstLineMapPerformIterativeAction(
+		LineMap *map,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	);
+
+/* unmap the file and free all of the memory in the map */
+void lstLineMapDestroy(LineMap *map);
+
+#endif /* __LINE_MAP_HEADER__ */
@@ -0,0 +1,50 @@
+/**
+ * Find newlines 32 bytes at a time, using AVX2 if the compiler is
+ * targeting it and two SSE2 halves otherwise.
+ */
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "LLLineScan.h"
+
+
+size_t
+lstFindNewline(const char *buffer, size_t len)
+{
+	size_t pos = 0;
+
+#if defined(__AVX2__)
+	const __m256i newlines = _mm256_set1_epi8('\n');
+	unsigned int mask;
+
+	for ( ; pos + 32 <= len; pos += 32) {
+		mask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256((const __m256i *) &buffer[pos]),
+					newlines));
+		if (mask != 0)
+			return pos + __builtin_ctz(mask);
+	}
+#elif defined(__SSE2__)
+	const __m128i newlines = _mm_set1_epi8('\n');
+	unsigned int mask;
+
+	for ( ; pos + 32 <= len; pos += 32) {
+		mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *) &buffer[pos]),
+					newlines))
+			| ((unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *) &buffer[pos + 16]),
+					newlines)) << 16);
+		if (mask != 0)
+			return pos + __builtin_ctz(mask);
+	}
+#endif
+
+	/** whatever is left is too short for a vector */
+	for ( ; pos < len; pos++) {
+		if (buffer[pos] == '\n')
+			return pos;
+	}
+	return len;
+}
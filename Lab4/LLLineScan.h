@@ -0,0 +1,14 @@
+/**
+ * Header file for the vectorized newline scanner used by the
+ * memory mapped line tools.
+ */
+
+#ifndef __LINE_SCAN_HEADER__
+#define __LINE_SCAN_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+/* offset of the first newline in buffer, or len if there is none */
+size_t lstFindNewline(const char *buffer, size_t len);
+
+#endif /* __LINE_SCAN_HEADER__ */
@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h> /* for memset() */
+#include <errno.h>
+#include <fcntl.h>	/* for open() */
+#include <unistd.h>	/* for close() */
+#include <pthread.h>
+#include <sys/mman.h>	/* for mmap() */
+#include <sys/stat.h>	/* for fstat() */
+
+#include "LLLineStats.h"	/* include our macros and prototypes */
+#include "LLLineScan.h"
+
+/** how much we read at a time when scanning on a single thread */
+#define	STATS_BUFFER_SIZE	(256 * 1024)
+
+/** the most threads we will split a file across */
+#define	STATS_MAX_THREADS	64
+
+
+/**
+ * What one chunk of the file tells us.  Lines that lie completely
+ * inside the chunk go straight into "inner".  The first and last
+ * pieces of the chunk may belong to lines that started or end in
+ * another chunk, so only their lengths are kept until the chunks
+ * are put back together in order.
+ */
+typedef struct ChunkStats {
+	const char *text;
+	unsigned long long offset;	/* where the chunk is in the file */
+	size_t len;
+
+	int hasNewline;
+	size_t headLen;				/* up to and including the first newline */
+	size_t tailLen;				/* after the last newline */
+	LineStats inner;
+} ChunkStats;
+
+/** the line currently being put together while merging chunks */
+typedef struct LineInProgress {
+	unsigned long long start;
+	unsigned long long length;
+} LineInProgress;
+
+
+int
+lstLineStatsBucket(unsigned long long length)
+{
+	int bucket = 0;
+
+	while (length > 0 && bucket < LST_LINE_HISTOGRAM_BUCKETS - 1) {
+		length >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/**
+ * Count one whole line, whose length includes its newline if it has
+ * one (only the last line of a file may not).  Only a strictly
+ * longer line replaces the longest so far, so as long as lines are
+ * added in file order we keep the first of several equally long ones.
+ */
+static void
+addLine(LineStats *stats, unsigned long long start, unsigned long long length,
+		int hasNewline)
+{
+	stats->nLines++;
+	stats->histogram[lstLineStatsBucket(length - (hasNewline ? 1 : 0))]++;
+	if (length > stats->longestLength) {
+		stats->longestLength = length;
+		stats->longestOffset = start;
+	}
+}
+
+/** add the statistics of lines that come after all of those in "into" */
+static void
+mergeStats(LineStats *into, const LineStats *from)
+{
+	int b;
+
+	into->nLines += from->nLines;
+	for (b = 0; b < LST_LINE_HISTOGRAM_BUCKETS; b++)
+		into->histogram[b] += from->histogram[b];
+	if (from->longestLength > into->longestLength) {
+		into->longestLength = from->longestLength;
+		into->longestOffset = from->longestOffset;
+	}
+}
+
+static void *
+scanChunk(void *vChunk)
+{
+	ChunkStats *chunk = (ChunkStats *) vChunk;
+	size_t pos, end;
+
+	memset(&chunk->inner, 0, sizeof(LineStats));
+	chunk->hasNewline = 0;
+
+	end = lstFindNewline(chunk->text, chunk->len);
+	if (end == chunk->len) {
+		chunk->headLen = chunk->tailLen = chunk->len;
+		return NULL;
+	}
+
+	chunk->hasNewline = 1;
+	chunk->headLen = end + 1;
+
+	for (pos = chunk->headLen; pos < chunk->len; pos = end + 1) {
+		end = pos + lstFindNewline(&chunk->text[pos], chunk->len - pos);
+		if (end == chunk->len)
+			break;
+		addLine(&chunk->inner, chunk->offset + pos, end + 1 - pos, 1);
+	}
+	chunk->tailLen = chunk->len - pos;
+	return NULL;
+}
+
+/**
+ * Put the next chunk (in file order) onto the statistics so far
+ */
+static void
+mergeChunk(LineStats *stats, LineInProgress *line, const ChunkStats *chunk)
+{
+	if ( ! chunk->hasNewline) {
+		if (line->length == 0)
+			line->start = chunk->offset;
+		line->length += chunk->len;
+		return;
+	}
+
+	if (line->length == 0)
+		line->start = chunk->offset;
+	addLine(stats, line->start, line->length + chunk->headLen, 1);
+	mergeStats(stats, &chunk->inner);
+
+	line->start = chunk->offset + chunk->len - chunk->tailLen;
+	line->length = chunk->tailLen;
+}
+
+/** a last line without a newline still counts */
+static void
+finishStats(LineStats *stats, LineInProgress *line)
+{
+	if (line->length > 0)
+		addLine(stats, line->start, line->length, 0);
+}
+
+
+/**
+ * Read the file a buffer at a time on this thread -- each buffer
+ * is simply treated as the next chunk
+ */
+static int
+lineStatsSerial(FILE *ifp, LineStats *stats)
+{
+	static char buffer[STATS_BUFFER_SIZE];
+	LineInProgress line = { 0, 0 };
+	ChunkStats chunk;
+
+	chunk.text = buffer;
+	chunk.offset = 0;
+	while ((chunk.len = fread(buffer, 1, sizeof(buffer), ifp)) > 0) {
+		scanChunk(&chunk);
+		mergeChunk(stats, &line, &chunk);
+		chunk.offset += chunk.len;
+	}
+	if (ferror(ifp))
+		return -1;
+
+	finishStats(stats, &line);
+	return 0;
+}
+
+/**
+ * Map the file and scan one chunk of it per thread, then merge
+ * the chunks in order
+ */
+static int
+lineStatsParallel(int fd, size_t size, int nThreads, LineStats *stats)
+{
+	ChunkStats chunks[STATS_MAX_THREADS];
+	pthread_t threads[STATS_MAX_THREADS];
+	int threadStarted[STATS_MAX_THREADS];
+	LineInProgress line = { 0, 0 };
+	const char *text;
+	size_t chunkSize;
+	int t;
+
+	text = (const char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (text == MAP_FAILED)
+		return -1;
+
+	if (nThreads > STATS_MAX_THREADS)
+		nThreads = STATS_MAX_THREADS;
+	chunkSize = (size + nThreads - 1) / nThreads;
+
+	for (t = 0; t < nThreads; t++) {
+		chunks[t].offset = (unsigned long long) t * chunkSize;
+		chunks[t].text = &text[chunks[t].offset];
+		chunks[t].len = (t + 1 < nThreads) ? chunkSize : size - chunks[t].offset;
+		threadStarted[t] = (pthread_create(&threads[t], NULL,
+					scanChunk, &chunks[t]) == 0);
+		if ( ! threadStarted[t])
+			scanChunk(&chunks[t]);
+	}
+
+	for (t = 0; t < nThreads; t++) {
+		if (threadStarted[t])
+			pthread_join(threads[t], NULL);
+		mergeChunk(stats, &line, &chunks[t]);
+	}
+	finishStats(stats, &line);
+
+	munmap((void *) text, size);
+	return 0;
+}
+
+int
+lstLineStatsFromFile(const char *filename, int nThreads, LineStats *stats)
+{
+	struct stat sb;
+	FILE *ifp;
+	int status;
+
+	memset(stats, 0, sizeof(LineStats));
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL)
+		return -1;
+
+	/** splitting is only worth it (or possible) for big enough regular files */
+	if (nThreads > 1 && fstat(fileno(ifp), &sb) == 0 && S_ISREG(sb.st_mode)
+			&& (size_t) sb.st_size >= (size_t) nThreads * STATS_BUFFER_SIZE)
+		status = lineStatsParallel(fileno(ifp), sb.st_size, nThreads, stats);
+	else
+		status = lineStatsSerial(ifp, stats);
+
+	fclose(ifp);
+	return status;
+}
+
+/**
+ * We only remembered where the longest line is, so go back
+ * and copy it out of the file.  Returns -1 with errno set if it
+ * cannot be read (EIO if the file has become shorter since) or
+ * written out.
+ */
+int
+lstLineStatsWriteLongest(const char *filename, const LineStats *stats, FILE *ofp)
+{
+	char buffer[STATS_BUFFER_SIZE / 16];
+	unsigned long long remaining = stats->longestLength;
+	size_t nRead, want;
+	FILE *ifp;
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL)
+		return -1;
+	if (fseeko(ifp, (off_t) stats->longestOffset, SEEK_SET) != 0) {
+		fclose(ifp);
+		return -1;
+	}
+
+	while (remaining > 0) {
+		want = (remaining < sizeof(buffer)) ? remaining : sizeof(buffer);
+		if ((nRead = fread(buffer, 1, want, ifp)) == 0) {
+			if ( ! ferror(ifp))
+				errno = EIO;
+			break;
+		}
+		if (fwrite(buffer, 1, nRead, ofp) != nRead)
+			break;
+		remaining -= nRead;
+	}
+
+	fclose(ifp);
+	return (remaining == 0) ? 0 : -1;
+}
@@ -0,0 +1,53 @@
+/**
+ * Header file for streaming line statistics.
+ *
+ * When all we want is a summary of the lines in a file -- how many
+ * there are, the longest one and how their lengths are spread out --
+ * there is no need to build a list of them at all.  The file is read
+ * in a single pass with the vectorized newline scanner, using a fixed
+ * amount of memory however big the file is, optionally with the file
+ * split into chunks that are scanned in parallel.
+ *
+ * The longest line's length includes the newline, as for the strings
+ * that fgets() gives us when we do build a list, so that it matches
+ * what is reported when we do.  The histogram goes by the text of
+ * each line alone, so that an empty line is one of length 0; the two
+ * are labelled as such when printed.
+ */
+
+#ifndef __LINE_STATISTICS_HEADER__
+#define __LINE_STATISTICS_HEADER__
+
+#include <stdio.h>
+
+/**
+ * bucket 0 counts empty lines, and bucket b > 0 counts lines with
+ * lengths (not counting the newline) from 2^(b-1) up to 2^b - 1
+ */
+#define	LST_LINE_HISTOGRAM_BUCKETS	48
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct LineStats {
+	unsigned long long nLines;
+	unsigned long long longestLength;
+	unsigned long long longestOffset;	/* where the first longest line starts */
+	unsigned long long histogram[LST_LINE_HISTOGRAM_BUCKETS];
+} LineStats;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* gather the statistics for a file using nThreads threads, returning -1 on failure */
+int lstLineStatsFromFile(const char *filename, int nThreads, LineStats *stats);
+
+/* copy the longest line found in the file to ofp, returning -1 on failure */
+int lstLineStatsWriteLongest(const char *filename, const LineStats *stats, FILE *ofp);
+
+/* the histogram bucket for a line of the given length */
+int lstLineStatsBucket(unsigned long long length);
+
+#endif /* __LINE_STATISTICS_HEADER__ */
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+
+#include "LLNodePool.h"	/* include our macros and prototypes */
+#include "LLInstrument.h"	/* counters, if LST_INSTRUMENT is defined */
+
+
+/**
+ * Set up an empty pool.  No memory is allocated until the
+ * first node is asked for.
+ */
+void
+lstPoolInit(GenericNodePool *pool, int nodesPerSlab)
+{
+	pool->slabs = NULL;
+	pool->freeList = NULL;
+	pool->returnedList = NULL;
+	pool->nodesPerSlab = (nodesPerSlab > 0)
+			? nodesPerSlab : LST_POOL_DEFAULT_SLAB_NODES;
+	pool->nUnusedInSlab = 0;
+}
+
+
+/**
+ * Hand out a node, preferring ones that have been released (which
+ * come back in the order they were in when released), then any that
+ * other threads have returned, then the next unused node of the
+ * newest slab, and only then a new slab.
+ */
+GenericListNode *
+lstPoolCreateNode(GenericNodePool *pool, void * const userdata)
+{
+	GenericListNode *newNode = NULL;
+	GenericNodeSlab *newSlab = NULL;
+
+	/**
+	 * take everything other threads have returned in one go --
+	 * as we take the whole list, nobody can be part way through
+	 * using any node on it
+	 */
+	if (pool->freeList == NULL
+			&& __atomic_load_n(&pool->returnedList, __ATOMIC_RELAXED) != NULL)
+		pool->freeList = __atomic_exchange_n(&pool->returnedList, NULL,
+				__ATOMIC_ACQUIRE);
+
+	if (pool->freeList != NULL) {
+		newNode = pool->freeList;
+		pool->freeList = newNode->next;
+
+	} else {
+		if (pool->nUnusedInSlab == 0) {
+			newSlab = (GenericNodeSlab *) malloc(sizeof(GenericNodeSlab)
+					+ pool->nodesPerSlab * sizeof(GenericListNode));
+			if (newSlab == NULL)
+				return NULL;
+			LST_COUNT(bytesInSlabs, sizeof(GenericNodeSlab)
+					+ pool->nodesPerSlab * sizeof(GenericListNode));
+			newSlab->next = pool->slabs;
+			pool->slabs = newSlab;
+			pool->nUnusedInSlab = pool->nodesPerSlab;
+		}
+
+		newNode = &pool->slabs->nodes[
+				pool->nodesPerSlab - pool->nUnusedInSlab--];
+	}
+
+	LST_COUNT(nNodesCreated, 1);
+	LST_COUNT(bytesOutstanding, sizeof(GenericListNode));
+
+	newNode->next = NULL;
+	newNode->data = userdata;
+	return newNode;
+}
+
+
+/**
+ * Put a single node on the front of the free list
+ */
+void
+lstPoolReleaseNode(GenericNodePool *pool, GenericListNode *node)
+{
+	node->next = pool->freeList;
+	pool->freeList = node;
+
+	LST_COUNT(nNodesDestroyed, 1);
+	LST_COUNT(bytesOutstanding, -(long long) sizeof(GenericListNode));
+}
+
+
+/**
+ * Give all of the nodes in list back to the pool, leaving list
+ * empty.  The nodes are already linked together, so once any
+ * per-node useraction is done the whole chain is put on the free
+ * list at once using the tail in the handle.
+ */
+void
+lstPoolReleaseList(
+		GenericNodePool *pool,
+		GenericList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	)
+{
+	GenericListNode *curNode = NULL;
+
+	if (list->head == NULL)
+		return;
+
+	if (useraction != NULL) {
+		for (curNode = list->head; curNode != NULL; curNode = curNode->next)
+			(*useraction)(curNode, userdata);
+	}
+
+	list->tail->next = pool->freeList;
+	pool->freeList = list->head;
+
+	LST_COUNT(nNodesDestroyed, list->count);
+	LST_COUNT(bytesOutstanding,
+			-(long long) (list->count * sizeof(GenericListNode)));
+
+	lstInitList(list);
+}
+
+
+/**
+ * Give all of the nodes in list back to the pool from a thread other
+ * than the one that owns it, leaving list empty.  The whole chain is
+ * pushed onto the returned list with a single compare and swap; the
+ * owner picks it up the next time its free list runs dry.
+ */
+void
+lstPoolReturnList(GenericNodePool *pool, GenericList *list)
+{
+	GenericListNode *oldHead = NULL;
+
+	if (list->head == NULL)
+		return;
+
+	oldHead = __atomic_load_n(&pool->returnedList, __ATOMIC_RELAXED);
+	do {
+		list->tail->next = oldHead;
+	} while ( ! __atomic_compare_exchange_n(&pool->returnedList,
+				&oldHead, list->head, 1,
+				__ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+	LST_COUNT(nNodesDestroyed, list->count);
+	LST_COUNT(bytesOutstanding,
+			-(long long) (list->count * sizeof(GenericListNode)));
+
+	lstInitList(list);
+}
+
+
+/**
+ * Free every slab.  Any node that came from this pool is invalid
+ * after this, whether or not it was released.
+ */
+void
+lstPoolDestroy(GenericNodePool *pool)
+{
+	GenericNodeSlab *nextSlab = NULL, *curSlab = NULL;
+
+	curSlab = pool->slabs;
+	while (curSlab != NULL) {
+		nextSlab = curSlab->next;
+		free(curSlab);
+		curSlab = nextSlab;
+	}
+
+	lstPoolInit(pool, pool->nodesPerSlab);
+}
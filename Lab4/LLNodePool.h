@@ -0,0 +1,68 @@
+/**
+ * Header file for the GenericListNode pool allocator.
+ *
+ * Rather than calling malloc() for every 16 byte node, the pool
+ * carves nodes out of large contiguous "slabs" and keeps released
+ * nodes on a free list to be handed out again.  Nodes allocated one
+ * after another therefore sit next to each other in memory, and a
+ * whole list can be given back in a single call.
+ *
+ * A pool belongs to a single thread: only lstPoolReturnList() may
+ * be called on it from other threads.  Nodes may be returned to a
+ * different pool than the one they came from, as long as the pools
+ * are all destroyed together once the nodes are no longer in use.
+ */
+
+#ifndef __GENERIC_NODE_POOL_HEADER__
+#define __GENERIC_NODE_POOL_HEADER__
+
+#include "LLGeneric.h"
+
+/** number of nodes in each slab unless the caller asks for another size */
+#define	LST_POOL_DEFAULT_SLAB_NODES	4096
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct GenericNodeSlab {
+	struct GenericNodeSlab *next;
+	GenericListNode nodes[];
+} GenericNodeSlab;
+
+typedef struct GenericNodePool {
+	GenericNodeSlab *slabs;		/* every slab we have allocated */
+	GenericListNode *freeList;	/* released nodes, linked through next */
+	GenericListNode *returnedList;	/* nodes given back by other threads */
+	int nodesPerSlab;
+	int nUnusedInSlab;			/* nodes never yet handed out in slabs */
+} GenericNodePool;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up an empty pool; nodesPerSlab <= 0 means use the default */
+void lstPoolInit(GenericNodePool *pool, int nodesPerSlab);
+
+/* create and initialize a node from the pool */
+GenericListNode *lstPoolCreateNode(GenericNodePool *pool, void *value);
+
+/* give a single node back to the pool */
+void lstPoolReleaseNode(GenericNodePool *pool, GenericListNode *node);
+
+/* give a whole list back to the pool, calling useraction (if not NULL) on each node */
+void lstPoolReleaseList(
+		GenericNodePool *pool,
+		GenericList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	);
+
+/* give a whole list back to the pool from any thread */
+void lstPoolReturnList(GenericNodePool *pool, GenericList *list);
+
+/* free all of the memory in the pool, including any nodes still in use */
+void lstPoolDestroy(GenericNodePool *pool);
+
+#endif /* __GENERIC_NODE_POOL_HEADER__ */
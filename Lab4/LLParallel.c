@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "LLParallel.h"	/* include our macros and prototypes */
+#include "LLInstrument.h"	/* counters, if LST_INSTRUMENT is defined */
+
+
+/** what each thread needs to know about its part of the list */
+typedef struct SegmentJob {
+	GenericListNode *head;
+	int firstIndex;
+	int nNodes;
+	int (*action)(GenericListNode *, int, void *);
+	void *userdata;
+	int *stopFlag;
+	int status;
+	int threadStarted;
+} SegmentJob;
+
+
+/**
+ * Pick where each segment starts out of the nodes the list handle
+ * remembers in skip[], so that there is no walk along the list
+ * (unless nodes have been moved about since skip[] was last right,
+ * when it is built again first).  Segments are as even as the skip
+ * stride allows.  Returns the number of segments actually used,
+ * which is fewer than asked for on a short list.
+ */
+int
+lstFindSegmentHeads(
+		GenericList *list,
+		int nSegments,
+		GenericListNode **heads,
+		int *firstIndex
+	)
+{
+	int segment, entry, lastEntry = -1, nUsed = 0;
+
+	if (list->count == 0)
+		return 0;
+
+	lstListRefreshSkips(list);
+
+	for (segment = 0; segment < nSegments; segment++) {
+		entry = (int) (((long long) segment * list->nSkip) / nSegments);
+		if (entry == lastEntry)
+			continue;
+		heads[nUsed] = list->skip[entry];
+		firstIndex[nUsed] = entry * list->skipStride;
+		nUsed++;
+		lastEntry = entry;
+	}
+	return nUsed;
+}
+
+static void *
+segmentThread(void *vJob)
+{
+	SegmentJob *job = (SegmentJob *) vJob;
+	GenericListNode *curNode = NULL;
+	int i;
+
+	job->status = 0;
+	curNode = job->head;
+	for (i = 0; i < job->nNodes; i++) {
+		/** another thread has failed, so there is no point carrying on */
+		if (__atomic_load_n(job->stopFlag, __ATOMIC_RELAXED))
+			break;
+
+		job->status = (*job->action)(curNode, job->firstIndex + i, job->userdata);
+		if (job->status < 0) {
+			__atomic_store_n(job->stopFlag, 1, __ATOMIC_RELAXED);
+			break;
+		}
+		curNode = curNode->next;
+	}
+	return NULL;
+}
+
+/**
+ * Process this list on nThreads threads, returning the number of
+ * nodes processed, or the first (in list order) negative value
+ * returned by the action
+ */
+int
+lstPerformParallelAction(
+		GenericList *list,
+		int nThreads,
+		int (*action)(GenericListNode *, int, void *),
+		void *threadUserdata,
+		size_t userdataSize,
+		void (*combine)(void *into, const void *from)
+	)
+{
+	GenericListNode *heads[LST_MAX_THREADS];
+	int firstIndex[LST_MAX_THREADS];
+	SegmentJob jobs[LST_MAX_THREADS];
+	pthread_t threads[LST_MAX_THREADS];
+	char *userdataArray = (char *) threadUserdata;
+	int nSegments, t, stopFlag = 0, status = 0;
+
+	if (nThreads < 1)
+		nThreads = 1;
+	if (nThreads > LST_MAX_THREADS)
+		nThreads = LST_MAX_THREADS;
+
+	nSegments = lstFindSegmentHeads(list, nThreads, heads, firstIndex);
+
+	for (t = 0; t < nSegments; t++) {
+		jobs[t].head = heads[t];
+		jobs[t].firstIndex = firstIndex[t];
+		jobs[t].nNodes = ((t + 1 < nSegments) ? firstIndex[t + 1] : list->count)
+				- firstIndex[t];
+		jobs[t].action = action;
+		jobs[t].userdata = &userdataArray[t * userdataSize];
+		jobs[t].stopFlag = &stopFlag;
+
+		/** the first segment is done on this thread, once the others are going */
+		jobs[t].threadStarted = (t > 0 && pthread_create(&threads[t], NULL,
+					segmentThread, &jobs[t]) == 0);
+	}
+
+	for (t = 0; t < nSegments; t++) {
+		if ( ! jobs[t].threadStarted)
+			segmentThread(&jobs[t]);
+	}
+	for (t = 0; t < nSegments; t++) {
+		if (jobs[t].threadStarted)
+			pthread_join(threads[t], NULL);
+		if (status == 0 && jobs[t].status < 0)
+			status = jobs[t].status;
+	}
+
+	if (status < 0)
+		return status;
+
+	for (t = 1; t < nSegments; t++)
+		(*combine)(userdataArray, &userdataArray[t * userdataSize]);
+
+	LST_COUNT(nIterateCalls, 1);
+	LST_COUNT(nIterateHops, list->count);
+	LST_COUNT_LENGTH(list->count);
+	return list->count;
+}
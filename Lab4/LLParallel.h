@@ -0,0 +1,53 @@
+/**
+ * Header file for parallel (map-reduce style) iteration over a
+ * generic linked list.
+ *
+ * The list is split into one segment per thread.  Each thread runs
+ * the usual iteration callback over its segment with its own copy
+ * of the user data, so the callback needs no locking.  Once all of
+ * the threads are done, a user supplied "combine" function merges
+ * the per-thread results together.
+ */
+
+#ifndef __GENERIC_PARALLEL_ITERATION_HEADER__
+#define __GENERIC_PARALLEL_ITERATION_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+#include "LLGeneric.h"
+
+/** the most threads we will split a list across */
+#define	LST_MAX_THREADS		64
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/**
+ * threadUserdata points at an array of nThreads user data structures,
+ * each userdataSize bytes long, set up by the caller.  Thread t passes
+ * element t to each call of action.  Afterwards, combine(into, from)
+ * is called with into = element 0 and from = each of elements 1 to
+ * nThreads - 1 in list order, so element 0 holds the final result.
+ *
+ * The index passed to action is the node's position in the whole
+ * list, as with lstPerformIterativeAction().
+ */
+int lstPerformParallelAction(
+		GenericList *list,
+		int nThreads,
+		int (*action)(GenericListNode *, int, void *),
+		void *threadUserdata,
+		size_t userdataSize,
+		void (*combine)(void *into, const void *from)
+	);
+
+/* fill in the first node of each of nSegments equal segments of list */
+int lstFindSegmentHeads(
+		GenericList *list,
+		int nSegments,
+		GenericListNode **heads,
+		int *firstIndex
+	);
+
+#endif /* __GENERIC_PARALLEL_ITERATION_HEADER__ */
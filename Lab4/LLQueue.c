@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LLQueue.h"	/* include our macros and prototypes */
+
+
+void
+lstQueueInit(GenericListQueue *queue)
+{
+	queue->stub.next = NULL;
+	queue->stub.data = NULL;
+	queue->head = &queue->stub;
+	queue->tail = &queue->stub;
+}
+
+
+/**
+ * Swap ourselves in as the new tail, then link the old tail to us.
+ *
+ * Between those two steps the queue is briefly "broken" (the old
+ * tail has no next yet); the consumer treats that the same as the
+ * queue being empty and will see the node on its next try.
+ */
+void
+lstQueuePush(GenericListQueue *queue, GenericListNode *node)
+{
+	GenericListNode *prev = NULL;
+
+	__atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
+	prev = __atomic_exchange_n(&queue->tail, node, __ATOMIC_ACQ_REL);
+	__atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * Take the oldest node, or return NULL if there is none (or if the
+ * only one left is still being pushed)
+ */
+GenericListNode *
+lstQueuePop(GenericListQueue *queue)
+{
+	GenericListNode *head = queue->head;
+	GenericListNode *next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+
+	/** step past the stub if it is at the front */
+	if (head == &queue->stub) {
+		if (next == NULL)
+			return NULL;
+		queue->head = next;
+		head = next;
+		next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+	}
+
+	if (next != NULL) {
+		queue->head = next;
+		return head;
+	}
+
+	/** a producer has swapped in a new tail but not linked it yet */
+	if (head != __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE))
+		return NULL;
+
+	/**
+	 * head is the last node: put the stub back behind it so that
+	 * we can take head without leaving the queue without a node
+	 */
+	lstQueuePush(queue, &queue->stub);
+	next = __atomic_load_n(&head->next, __ATOMIC_ACQUIRE);
+	if (next != NULL) {
+		queue->head = next;
+		return head;
+	}
+	return NULL;
+}
+
+
+/**
+ * Move nodes from the queue onto the end of a list, returning how
+ * many were moved
+ */
+int
+lstQueueDrainToList(GenericListQueue *queue, GenericList *list, int maxNodes)
+{
+	GenericListNode *node = NULL;
+	int nMoved = 0;
+
+	while ((maxNodes <= 0 || nMoved < maxNodes)
+			&& (node = lstQueuePop(queue)) != NULL) {
+		lstListAppend(list, node);
+		nMoved++;
+	}
+	return nMoved;
+}
+
+
+/**
+ * Take a batch of nodes off the queue and process them with the
+ * usual iteration callback (the index counts from 0 within this
+ * batch).  Afterwards the nodes are given back to pool in a single
+ * call -- typically the pool of a producer -- or left for the action
+ * to have dealt with if pool is NULL.
+ *
+ * As with lstPerformIterativeAction(), returns the number of nodes
+ * processed or the negative value returned by the action; either
+ * way every node in the batch is given back.
+ */
+int
+lstQueueDrain(
+		GenericListQueue *queue,
+		int maxNodes,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata,
+		GenericNodePool *pool
+	)
+{
+	GenericList batch;
+	int status;
+
+	lstInitList(&batch);
+	if (lstQueueDrainToList(queue, &batch, maxNodes) == 0)
+		return 0;
+
+	status = lstPerformIterativeAction(batch.head, action, userdata);
+
+	if (pool != NULL)
+		lstPoolReturnList(pool, &batch);
+	return status;
+}
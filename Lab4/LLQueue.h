@@ -0,0 +1,57 @@
+/**
+ * Header file for a lock-free multi-producer, single-consumer queue
+ * of GenericListNodes.
+ *
+ * Any number of threads may push nodes at the same time without
+ * taking a lock: a push is one atomic exchange of the tail pointer
+ * followed by one store, so it takes the same time however many
+ * producers there are.  A single consumer thread pops or drains
+ * nodes in the order they were pushed.
+ *
+ * This is the "intrusive" queue design due to Dmitry Vyukov: the
+ * nodes' own next pointers link the queue, and a "stub" node inside
+ * the queue keeps it from ever being truly empty.
+ */
+
+#ifndef __GENERIC_LIST_QUEUE_HEADER__
+#define __GENERIC_LIST_QUEUE_HEADER__
+
+#include "LLGeneric.h"
+#include "LLNodePool.h"
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct GenericListQueue {
+	GenericListNode *tail;		/* where producers add -- atomic */
+	GenericListNode *head;		/* where the consumer takes from */
+	GenericListNode stub;
+} GenericListQueue;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up an empty queue */
+void lstQueueInit(GenericListQueue *queue);
+
+/* add a node to the queue -- safe to call from any number of threads */
+void lstQueuePush(GenericListQueue *queue, GenericListNode *node);
+
+/* take the oldest node from the queue (consumer only) */
+GenericListNode *lstQueuePop(GenericListQueue *queue);
+
+/* move up to maxNodes nodes (all if maxNodes <= 0) onto the end of list */
+int lstQueueDrainToList(GenericListQueue *queue, GenericList *list, int maxNodes);
+
+/* process up to maxNodes nodes as a batch, then return them to pool */
+int lstQueueDrain(
+		GenericListQueue *queue,
+		int maxNodes,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata,
+		GenericNodePool *pool
+	);
+
+#endif /* __GENERIC_LIST_QUEUE_HEADER__ */
@@ -0,0 +1,295 @@
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+
+#include "LLSkipList.h"	/* include our macros and prototypes */
+
+/** how much memory to carve nodes from at a time */
+#define	SKIP_SLAB_SIZE	(64 * 1024)
+
+#define	SKIP_NODE_SIZE(height) \
+		(sizeof(SkipListNode) + (height) * sizeof(SkipListNode *))
+
+
+/**
+ * xorshift64* -- a few shifts and a multiply per number, which
+ * is plenty random enough to choose tower heights
+ */
+static unsigned long long
+skipNextRandom(SkipList *list)
+{
+	unsigned long long x = list->randomState;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	list->randomState = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * Each level up has a one in four chance, so we look at the random
+ * bits two at a time and count how many pairs in a row are zero
+ */
+static int
+skipRandomHeight(SkipList *list)
+{
+	unsigned long long bits = skipNextRandom(list);
+	int height = 1;
+
+	while (height < LST_SKIP_MAX_LEVEL && (bits & 3) == 0) {
+		height++;
+		bits >>= 2;
+	}
+	return height;
+}
+
+
+/**
+ * Get a node of the given height, reusing a released one if we can
+ */
+static SkipListNode *
+skipAllocNode(SkipList *list, int height)
+{
+	SkipListNode *node = NULL;
+	SkipListSlab *slab = NULL;
+	size_t size = SKIP_NODE_SIZE(height);
+
+	if (list->freeByHeight[height] != NULL) {
+		node = list->freeByHeight[height];
+		list->freeByHeight[height] = node->forward[0];
+
+	} else {
+		/* keep nodes pointer aligned within the slab */
+		size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+		if (list->slabs == NULL || list->slabs->used + size > list->slabs->size) {
+			slab = (SkipListSlab *) malloc(sizeof(SkipListSlab) + SKIP_SLAB_SIZE);
+			if (slab == NULL)
+				return NULL;
+			slab->next = list->slabs;
+			slab->used = 0;
+			slab->size = SKIP_SLAB_SIZE;
+			list->slabs = slab;
+		}
+		node = (SkipListNode *) &list->slabs->memory[list->slabs->used];
+		list->slabs->used += size;
+	}
+
+	node->height = height;
+	return node;
+}
+
+static void
+skipReleaseNode(SkipList *list, SkipListNode *node)
+{
+	node->forward[0] = list->freeByHeight[node->height];
+	list->freeByHeight[node->height] = node;
+}
+
+
+int
+lstSkipInit(
+		SkipList *list,
+		int (*comparator)(const void *, const void *),
+		unsigned long long seed
+	)
+{
+	int i;
+
+	list->level = 1;
+	list->count = 0;
+	list->comparator = comparator;
+	list->randomState = (seed != 0) ? seed : 0x9E3779B97F4A7C15ULL;
+	list->slabs = NULL;
+	for (i = 0; i <= LST_SKIP_MAX_LEVEL; i++)
+		list->freeByHeight[i] = NULL;
+
+	list->head = skipAllocNode(list, LST_SKIP_MAX_LEVEL);
+	if (list->head == NULL)
+		return -1;
+	list->head->data = NULL;
+	for (i = 0; i < LST_SKIP_MAX_LEVEL; i++)
+		list->head->forward[i] = NULL;
+	return 0;
+}
+
+
+/**
+ * Walk down from the top level, recording in "update" the last node
+ * on each level that comes before the key.  With orEqual set, nodes
+ * equal to the key count as "before" it too, which is what we want
+ * when inserting after any equal elements.
+ *
+ * Returns the level 0 successor of update[0].
+ */
+static SkipListNode *
+skipFindPredecessors(SkipList *list, const void *key, int orEqual,
+		SkipListNode **update)
+{
+	SkipListNode *curNode = list->head;
+	SkipListNode *next = NULL;
+	int level, c;
+
+	for (level = list->level - 1; level >= 0; level--) {
+		while ((next = curNode->forward[level]) != NULL) {
+			c = (*list->comparator)(key, next->data);
+			if (c < 0 || (c == 0 && ! orEqual))
+				break;
+			curNode = next;
+		}
+		if (update != NULL)
+			update[level] = curNode;
+	}
+	return curNode->forward[0];
+}
+
+int
+lstSkipInsert(SkipList *list, void *data)
+{
+	SkipListNode *update[LST_SKIP_MAX_LEVEL];
+	SkipListNode *newNode = NULL;
+	int height, level;
+
+	skipFindPredecessors(list, data, 1, update);
+
+	height = skipRandomHeight(list);
+	if ((newNode = skipAllocNode(list, height)) == NULL)
+		return -1;
+	newNode->data = data;
+
+	/** a taller tower than any so far starts from the head on the new levels */
+	for (level = list->level; level < height; level++)
+		update[level] = list->head;
+	if (height > list->level)
+		list->level = height;
+
+	for (level = 0; level < height; level++) {
+		newNode->forward[level] = update[level]->forward[level];
+		update[level]->forward[level] = newNode;
+	}
+
+	list->count++;
+	return 0;
+}
+
+void *
+lstSkipFind(SkipList *list, const void *key)
+{
+	SkipListNode *node = NULL;
+
+	node = skipFindPredecessors(list, key, 0, NULL);
+	if (node != NULL && (*list->comparator)(key, node->data) == 0)
+		return node->data;
+	return NULL;
+}
+
+void *
+lstSkipDelete(SkipList *list, const void *key)
+{
+	SkipListNode *update[LST_SKIP_MAX_LEVEL];
+	SkipListNode *node = NULL;
+	void *data = NULL;
+	int level;
+
+	node = skipFindPredecessors(list, key, 0, update);
+	if (node == NULL || (*list->comparator)(key, node->data) != 0)
+		return NULL;
+
+	for (level = 0; level < node->height; level++)
+		update[level]->forward[level] = node->forward[level];
+
+	while (list->level > 1 && list->head->forward[list->level - 1] == NULL)
+		list->level--;
+
+	data = node->data;
+	skipReleaseNode(list, node);
+	list->count--;
+	return data;
+}
+
+int
+lstSkipLength(const SkipList *list)
+{
+	return list->count;
+}
+
+
+/**
+ * Process the elements between low and high (inclusive) in order,
+ * returning the number processed, or a negative value on error.  A
+ * NULL low starts at the beginning and a NULL high runs to the end.
+ *
+ * As for the unrolled list, the callback is given a GenericListNode
+ * (whose next is always NULL) holding the payload, and the index is
+ * counted from 0 at the first element in the range.  Changing the
+ * node's data in the callback does not change the list.
+ */
+int
+lstSkipPerformRangeAction(
+		SkipList *list,
+		const void *low,
+		const void *high,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	)
+{
+	SkipListNode *curNode = NULL;
+	GenericListNode payloadNode;
+	int nodeCount, status;
+
+	if (low != NULL)
+		curNode = skipFindPredecessors(list, low, 0, NULL);
+	else
+		curNode = list->head->forward[0];
+
+	payloadNode.next = NULL;
+	nodeCount = 0;
+
+	while (curNode != NULL) {
+		if (high != NULL && (*list->comparator)(high, curNode->data) < 0)
+			break;
+		payloadNode.data = curNode->data;
+		status = (*action)(&payloadNode, nodeCount++, userdata);
+		if (status < 0)	return status;
+		curNode = curNode->forward[0];
+	}
+
+	return nodeCount;
+}
+
+
+/**
+ * The nodes all live in the slabs, so once the user has seen each
+ * payload we only need to free those
+ */
+void
+lstSkipDestroy(
+		SkipList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	)
+{
+	SkipListNode *curNode = NULL;
+	SkipListSlab *nextSlab = NULL, *curSlab = NULL;
+	GenericListNode payloadNode;
+
+	if (useraction != NULL) {
+		payloadNode.next = NULL;
+		for (curNode = list->head->forward[0]; curNode != NULL;
+				curNode = curNode->forward[0]) {
+			payloadNode.data = curNode->data;
+			(*useraction)(&payloadNode, userdata);
+		}
+	}
+
+	curSlab = list->slabs;
+	while (curSlab != NULL) {
+		nextSlab = curSlab->next;
+		free(curSlab);
+		curSlab = nextSlab;
+	}
+
+	list->slabs = NULL;
+	list->head = NULL;
+	list->count = 0;
+}
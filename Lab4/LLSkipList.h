@@ -0,0 +1,93 @@
+/**
+ * Header file for an ordered skip list of generic payloads.
+ *
+ * Like the generic linked list, each element is just a (void *) to
+ * the user's own data.  The list is kept in the order given by a
+ * user supplied comparator (with the same signature as for qsort()
+ * or bsearch()), so an element can be found, added or removed with
+ * O(log n) expected comparisons instead of a walk of the whole list.
+ *
+ * Each node has a "tower" of forward pointers; level 0 links every
+ * node in order and each higher level skips over roughly three
+ * quarters of the nodes of the level below.  Tower heights are
+ * drawn from a fast xorshift random number generator, and nodes are
+ * carved out of slabs and recycled by height.
+ */
+
+#ifndef __SKIP_LIST_HEADER__
+#define __SKIP_LIST_HEADER__
+
+#include "LLGeneric.h"
+
+/** enough levels for about 4^16 (four billion) elements */
+#define	LST_SKIP_MAX_LEVEL	16
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct SkipListNode {
+	void *data;
+	int height;
+	struct SkipListNode *forward[];
+} SkipListNode;
+
+typedef struct SkipListSlab {
+	struct SkipListSlab *next;
+	size_t used;
+	size_t size;
+	char memory[];
+} SkipListSlab;
+
+typedef struct SkipList {
+	SkipListNode *head;			/* has a full height tower, but no data */
+	int level;					/* the highest level in use */
+	int count;
+	int (*comparator)(const void *, const void *);
+	unsigned long long randomState;
+
+	/** released nodes, by height, linked through forward[0] */
+	SkipListNode *freeByHeight[LST_SKIP_MAX_LEVEL + 1];
+	SkipListSlab *slabs;
+} SkipList;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up an empty list, returning -1 if out of memory */
+int lstSkipInit(
+		SkipList *list,
+		int (*comparator)(const void *, const void *),
+		unsigned long long seed
+	);
+
+/* add data in order (after any equal elements), returning -1 if out of memory */
+int lstSkipInsert(SkipList *list, void *data);
+
+/* find the first element that compares equal to key */
+void *lstSkipFind(SkipList *list, const void *key);
+
+/* remove the first element that compares equal to key, returning its data */
+void *lstSkipDelete(SkipList *list, const void *key);
+
+/* the number of elements in the list */
+int lstSkipLength(const SkipList *list);
+
+/* process the elements from low to high inclusive (NULL for no limit) in order */
+int lstSkipPerformRangeAction(
+		SkipList *list,
+		const void *low,
+		const void *high,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	);
+
+/* call useraction (if not NULL) on every element, then free all of the list */
+void lstSkipDestroy(
+		SkipList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	);
+
+#endif /* __SKIP_LIST_HEADER__ */
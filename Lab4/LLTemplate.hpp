@@ -0,0 +1,364 @@
+/**
+ * Header only C++ version of the generic linked list.
+ *
+ * In LLGeneric every payload is a separate (void *) allocation that
+ * each callback must cast back to what it knows it is, so the
+ * compiler can neither keep the payload inside the node nor inline
+ * the callback into the loop that walks the list.
+ *
+ * Here the list is a template on the payload type, so each node
+ * holds its payload directly, and the iterators take any callable
+ * (a lambda, a function object or a plain function), which the
+ * compiler sees in full at the point of the call.  A traversal over
+ * strings then compiles down to the same tight loop as hand written
+ * code.
+ *
+ * Nodes are obtained through an allocator that is also a template
+ * parameter: std::allocator by default, or lst::SlabAllocator which,
+ * like the node pool of LLNodePool.h, carves nodes out of large
+ * slabs and recycles them through a free list (and which is only
+ * meant for use with lst::List -- see below).
+ *
+ * performIterativeAction() lets existing callbacks written for
+ * lstPerformIterativeAction() run unchanged over a template list.
+ */
+
+#ifndef __GENERIC_LINKED_LIST_TEMPLATE_HEADER__
+#define __GENERIC_LINKED_LIST_TEMPLATE_HEADER__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+#include "LLGeneric.h"
+}
+
+namespace lst {
+
+/**
+ * An allocator that hands out single objects from slabs of
+ * nObjectsPerSlab at a time, keeping released objects on a free
+ * list.  All of the memory goes back when the allocator is
+ * destroyed.  Requests for more than one object at once (which a
+ * list never makes) go straight to operator new.
+ *
+ * The slabs are only good for objects of one size, so an allocator
+ * can neither be copied nor rebound from another one: two of them
+ * never share memory, and only compare equal to themselves.  That
+ * is less than the standard Allocator requirements ask for, so this
+ * is only meant for lst::List (which just moves its allocator),
+ * not for the standard containers.  The slabs are kept behind a
+ * pointer so that a moved allocator still compares equal to what
+ * it was moved from; the moved-from one may then only be destroyed
+ * or assigned to.
+ */
+template <typename T, std::size_t nObjectsPerSlab = 4096>
+class SlabAllocator {
+	union Slot {
+		Slot *nextFree;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	struct Slab {
+		Slab *next;
+		Slot slots[nObjectsPerSlab];
+	};
+
+	struct Pool {
+		Slab *slabs = nullptr;
+		Slot *freeList = nullptr;
+		std::size_t nUnusedInSlab = 0;
+	};
+
+	Pool *pool;
+
+	void release() noexcept
+	{
+		Slab *slab;
+
+		if (pool == nullptr)
+			return;
+		while (pool->slabs != nullptr) {
+			slab = pool->slabs;
+			pool->slabs = slab->next;
+			delete slab;
+		}
+		delete pool;
+		pool = nullptr;
+	}
+
+public:
+	typedef T value_type;
+	typedef std::false_type is_always_equal;
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	template <typename U>
+	struct rebind {
+		typedef SlabAllocator<U, nObjectsPerSlab> other;
+	};
+
+	SlabAllocator() : pool(new Pool) {}
+
+	/** see above for why these are not allowed */
+	SlabAllocator(const SlabAllocator &) = delete;
+	template <typename U>
+	SlabAllocator(const SlabAllocator<U, nObjectsPerSlab> &) = delete;
+	SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+	SlabAllocator(SlabAllocator &&other) noexcept : pool(other.pool)
+	{
+		other.pool = nullptr;
+	}
+
+	SlabAllocator &operator=(SlabAllocator &&other) noexcept
+	{
+		if (this != &other) {
+			release();
+			pool = other.pool;
+			other.pool = nullptr;
+		}
+		return *this;
+	}
+
+	~SlabAllocator()
+	{
+		release();
+	}
+
+	T *allocate(std::size_t n)
+	{
+		Slot *slot;
+		Slab *slab;
+
+		if (n != 1)
+			return static_cast<T *>(::operator new(n * sizeof(T)));
+
+		if (pool->freeList != nullptr) {
+			slot = pool->freeList;
+			pool->freeList = slot->nextFree;
+			return reinterpret_cast<T *>(slot->storage);
+		}
+
+		if (pool->nUnusedInSlab == 0) {
+			slab = new Slab;
+			slab->next = pool->slabs;
+			pool->slabs = slab;
+			pool->nUnusedInSlab = nObjectsPerSlab;
+		}
+
+		/** hand the slots out from the front so they are in memory order */
+		slot = &pool->slabs->slots[nObjectsPerSlab - pool->nUnusedInSlab--];
+		return reinterpret_cast<T *>(slot->storage);
+	}
+
+	void deallocate(T *p, std::size_t n) noexcept
+	{
+		Slot *slot;
+
+		if (n != 1) {
+			::operator delete(p);
+			return;
+		}
+		slot = reinterpret_cast<Slot *>(p);
+		slot->nextFree = pool->freeList;
+		pool->freeList = slot;
+	}
+
+	/** memory from one allocator can only go back to that same one */
+	bool operator==(const SlabAllocator &other) const noexcept
+	{
+		return pool == other.pool;
+	}
+	bool operator!=(const SlabAllocator &other) const noexcept
+	{
+		return ! (*this == other);
+	}
+};
+
+
+/**
+ * A singly linked list of T, keeping track of its tail and length
+ * like the GenericList handle does
+ */
+template <typename T, typename Allocator = std::allocator<T> >
+class List {
+	struct Node {
+		Node *next;
+		T data;
+
+		template <typename... Args>
+		Node(Args &&... args) : next(nullptr), data(std::forward<Args>(args)...) {}
+	};
+
+	typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>
+			NodeAllocator;
+	typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
+	Node *head = nullptr;
+	Node *tail = nullptr;
+	int count = 0;
+	NodeAllocator allocator;
+
+	template <typename... Args>
+	Node *createNode(Args &&... args)
+	{
+		Node *node = NodeTraits::allocate(allocator, 1);
+
+		try {
+			NodeTraits::construct(allocator, node, std::forward<Args>(args)...);
+		} catch (...) {
+			NodeTraits::deallocate(allocator, node, 1);
+			throw;
+		}
+		return node;
+	}
+
+	/**
+	 * What a GenericListNode would have held as its data: pointer
+	 * payloads are handed over as they are (so a List<char *> looks
+	 * exactly like a list of strings built with LLGeneric), and any
+	 * other payload is handed over by its address
+	 */
+	static void *asGenericData(T &data)
+	{
+		if constexpr (std::is_pointer<T>::value)
+			return const_cast<void *>(static_cast<const void *>(data));
+		else
+			return static_cast<void *>(std::addressof(data));
+	}
+
+public:
+	typedef T value_type;
+
+	List() {}
+	/** only for allocators that can be copied, unlike SlabAllocator */
+	explicit List(const Allocator &a) : allocator(a) {}
+
+	List(const List &) = delete;
+	List &operator=(const List &) = delete;
+
+	List(List &&other) noexcept
+		: head(other.head), tail(other.tail), count(other.count),
+		  allocator(std::move(other.allocator))
+	{
+		other.head = other.tail = nullptr;
+		other.count = 0;
+	}
+
+	~List()
+	{
+		clear();
+	}
+
+	/** add a payload, constructed from args in place, to the end */
+	template <typename... Args>
+	T &emplaceBack(Args &&... args)
+	{
+		Node *node = createNode(std::forward<Args>(args)...);
+
+		if (tail == nullptr)
+			head = node;
+		else
+			tail->next = node;
+		tail = node;
+		count++;
+		return node->data;
+	}
+
+	/** add a payload, constructed from args in place, to the front */
+	template <typename... Args>
+	T &emplaceFront(Args &&... args)
+	{
+		Node *node = createNode(std::forward<Args>(args)...);
+
+		node->next = head;
+		head = node;
+		if (tail == nullptr)
+			tail = node;
+		count++;
+		return node->data;
+	}
+
+	void append(const T &value)		{ emplaceBack(value); }
+	void append(T &&value)			{ emplaceBack(std::move(value)); }
+	void prepend(const T &value)	{ emplaceFront(value); }
+	void prepend(T &&value)			{ emplaceFront(std::move(value)); }
+
+	int length() const				{ return count; }
+	bool empty() const				{ return count == 0; }
+
+	/**
+	 * Call action(payload, index) on each payload in order.  As
+	 * with lstPerformIterativeAction(), if the action returns an
+	 * int then a negative value stops the walk and is returned;
+	 * otherwise the number of payloads processed is returned.
+	 */
+	template <typename Action>
+	int performIterativeAction(Action &&action)
+	{
+		int nodeCount = 0, status;
+		Node *curNode;
+
+		for (curNode = head; curNode != nullptr; curNode = curNode->next) {
+			if constexpr (std::is_void<decltype(action(curNode->data, 0))>::value) {
+				action(curNode->data, nodeCount++);
+			} else {
+				status = action(curNode->data, nodeCount++);
+				if (status < 0)
+					return status;
+			}
+		}
+		return nodeCount;
+	}
+
+	/**
+	 * Run a callback written for lstPerformIterativeAction() over
+	 * this list.  Each payload is handed over in a GenericListNode
+	 * of its own (see asGenericData() for what "data" holds), whose
+	 * "next" is always NULL.
+	 */
+	int performIterativeAction(
+			int (*action)(GenericListNode *, int, void *),
+			void *userdata)
+	{
+		GenericListNode node;
+
+		node.next = NULL;
+		return performIterativeAction(
+				[&](T &data, int index) {
+					node.data = asGenericData(data);
+					return (*action)(&node, index, userdata);
+				});
+	}
+
+	/** destroy every payload, calling useraction on each first */
+	template <typename UserAction>
+	void destroy(UserAction &&useraction)
+	{
+		Node *next;
+
+		while (head != nullptr) {
+			next = head->next;
+			useraction(head->data);
+			NodeTraits::destroy(allocator, head);
+			NodeTraits::deallocate(allocator, head, 1);
+			head = next;
+		}
+		tail = nullptr;
+		count = 0;
+	}
+
+	void clear()
+	{
+		destroy([](T &) {});
+	}
+};
+
+} /* namespace lst */
+
+#endif /* __GENERIC_LINKED_LIST_TEMPLATE_HEADER__ */
@@ -0,0 +1,154 @@
+#include <stdio.h>  /* I/O routines */
+#include <stdlib.h> /* for malloc() */
+#include <string.h> /* for memmove() */
+
+#include "LLUnrolled.h"	/* include our macros and prototypes */
+
+
+static UnrolledListNode *
+lstUnrolledCreateNode(void)
+{
+	UnrolledListNode *newNode = NULL;
+
+	newNode = (UnrolledListNode *) malloc(sizeof(UnrolledListNode));
+	if (newNode != NULL) {
+		newNode->next = NULL;
+		newNode->count = 0;
+	}
+	return newNode;
+}
+
+void
+lstUnrolledInit(UnrolledList *list)
+{
+	list->head = NULL;
+	list->tail = NULL;
+	list->count = 0;
+}
+
+
+/**
+ * Add to the end, filling up the last node before making a new one
+ */
+int
+lstUnrolledAppend(UnrolledList *list, void *value)
+{
+	UnrolledListNode *newNode = NULL;
+
+	if (list->tail == NULL || list->tail->count == LST_UNROLLED_SLOTS) {
+		if ((newNode = lstUnrolledCreateNode()) == NULL)
+			return -1;
+		if (list->tail == NULL)
+			list->head = newNode;
+		else
+			list->tail->next = newNode;
+		list->tail = newNode;
+	}
+
+	list->tail->data[list->tail->count++] = value;
+	list->count++;
+	return 0;
+}
+
+
+/**
+ * Add to the front.  Payloads are always packed at the start of
+ * their node, so if the first node has room we shuffle its (at most
+ * LST_UNROLLED_SLOTS) payloads along by one.
+ */
+int
+lstUnrolledPrepend(UnrolledList *list, void *value)
+{
+	UnrolledListNode *newNode = NULL;
+
+	if (list->head == NULL || list->head->count == LST_UNROLLED_SLOTS) {
+		if ((newNode = lstUnrolledCreateNode()) == NULL)
+			return -1;
+		newNode->next = list->head;
+		list->head = newNode;
+		if (list->tail == NULL)
+			list->tail = newNode;
+	}
+
+	memmove(&list->head->data[1], &list->head->data[0],
+			list->head->count * sizeof(void *));
+	list->head->data[0] = value;
+	list->head->count++;
+	list->count++;
+	return 0;
+}
+
+int
+lstUnrolledLength(const UnrolledList *list)
+{
+	return list->count;
+}
+
+
+/**
+ * Process this list using the user's supplied function and data,
+ * returning the number of payloads processed, or a negative value
+ * on error
+ *
+ * The callback is given a GenericListNode holding the payload, so
+ * callbacks written for lstPerformIterativeAction() work unchanged.
+ * That node is not part of any list (its next is always NULL), but
+ * any change the callback makes to its data is stored back.
+ */
+int
+lstUnrolledPerformIterativeAction(
+		UnrolledList *list,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	)
+{
+	UnrolledListNode *curNode = NULL;
+	GenericListNode payloadNode;
+	int nodeCount, status, i;
+
+	nodeCount = 0;
+	payloadNode.next = NULL;
+
+	for (curNode = list->head; curNode != NULL; curNode = curNode->next) {
+		for (i = 0; i < curNode->count; i++) {
+			payloadNode.data = curNode->data[i];
+			status = (*action)(&payloadNode, nodeCount++, userdata);
+			curNode->data[i] = payloadNode.data;
+			if (status < 0)	return status;
+		}
+	}
+
+	return nodeCount;
+}
+
+
+/**
+ * Chase through the list, freeing all memory it contains, after
+ * giving the user a chance to clean up each payload
+ */
+void
+lstUnrolledDestroy(
+		UnrolledList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	)
+{
+	UnrolledListNode *nextNode = NULL, *curNode = NULL;
+	GenericListNode payloadNode;
+	int i;
+
+	payloadNode.next = NULL;
+
+	curNode = list->head;
+	while (curNode != NULL) {
+		nextNode = curNode->next;
+		for (i = 0; i < curNode->count; i++) {
+			payloadNode.data = curNode->data[i];
+			(*useraction)(&payloadNode, userdata);
+		}
+		free(curNode);
+		curNode = nextNode;
+	}
+
+	lstUnrolledInit(list);
+}
@@ -0,0 +1,64 @@
+/**
+ * Header file for the "unrolled" generic linked list.
+ *
+ * Each node holds up to LST_UNROLLED_SLOTS payload pointers rather
+ * than just one, so walking the list follows one next pointer (and
+ * takes one likely cache miss) per group of payloads instead of per
+ * payload.
+ *
+ * Iteration uses the same callbacks as lstPerformIterativeAction().
+ */
+
+#ifndef __UNROLLED_LINKED_LIST_HEADER__
+#define __UNROLLED_LINKED_LIST_HEADER__
+
+#include "LLGeneric.h"
+
+/** payloads per node -- chosen so that a node fills two cache lines */
+#define	LST_UNROLLED_SLOTS	14
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct UnrolledListNode {
+	struct UnrolledListNode *next;
+	int count;
+	void *data[LST_UNROLLED_SLOTS];
+} UnrolledListNode;
+
+typedef struct UnrolledList {
+	UnrolledListNode *head;
+	UnrolledListNode *tail;
+	int count;
+} UnrolledList;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up an empty list */
+void lstUnrolledInit(UnrolledList *list);
+
+/* add a payload to the end of the list, returning -1 if out of memory */
+int lstUnrolledAppend(UnrolledList *list, void *value);
+
+/* add a payload to the front of the list, returning -1 if out of memory */
+int lstUnrolledPrepend(UnrolledList *list, void *value);
+
+/* the number of payloads in the list */
+int lstUnrolledLength(const UnrolledList *list);
+
+int lstUnrolledPerformIterativeAction(
+		UnrolledList *list,
+		int (*action)(GenericListNode *, int, void *),
+		void *userdata
+	);
+
+void lstUnrolledDestroy(
+		UnrolledList *list,
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	);
+
+#endif /* __UNROLLED_LINKED_LIST_HEADER__ */
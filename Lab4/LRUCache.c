@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+
+#include "LRUCache.h"	/* include our macros and prototypes */
+
+
+int
+lstCacheInit(
+		LRUCache *cache,
+		int capacity,
+		unsigned long (*hash)(const void *key),
+		int (*comparator)(const void *key1, const void *key2),
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	)
+{
+	unsigned long nBuckets = 1;
+	int i;
+
+	cache->newest = cache->oldest = NULL;
+	cache->count = 0;
+	cache->capacity = (capacity > 0) ? capacity : 1;
+	cache->hash = hash;
+	cache->comparator = comparator;
+	cache->useraction = useraction;
+	cache->userdata = userdata;
+	cache->nHits = cache->nMisses = cache->nEvictions = 0;
+
+	/** at least as many buckets as entries keeps the chains short */
+	while (nBuckets < (unsigned long) cache->capacity)
+		nBuckets <<= 1;
+	cache->bucketMask = nBuckets - 1;
+
+	cache->entries = (LRUCacheEntry *) malloc(
+			cache->capacity * sizeof(LRUCacheEntry));
+	cache->buckets = (GenericListNode **) calloc(
+			nBuckets, sizeof(GenericListNode *));
+	if (cache->entries == NULL || cache->buckets == NULL) {
+		free(cache->entries);
+		free(cache->buckets);
+		cache->entries = NULL;
+		cache->buckets = NULL;
+		return -1;
+	}
+
+	cache->unused = NULL;
+	for (i = cache->capacity - 1; i >= 0; i--) {
+		cache->entries[i].older = cache->unused;
+		cache->unused = &cache->entries[i];
+	}
+	return 0;
+}
+
+/**
+ * Find the link that points at the entry for key in its bucket, so
+ * that the caller can also unlink it.  The link holds NULL if the
+ * key is not in the cache.
+ */
+static GenericListNode **
+cacheFindLink(LRUCache *cache, const void *key, unsigned long hash)
+{
+	GenericListNode **link = &cache->buckets[hash & cache->bucketMask];
+	LRUCacheEntry *entry;
+
+	while (*link != NULL) {
+		entry = (LRUCacheEntry *) *link;
+		if (entry->hash == hash && (*cache->comparator)(entry->key, key) == 0)
+			break;
+		link = &(*link)->next;
+	}
+	return link;
+}
+
+/** take an entry off the list of entries in order of use */
+static void
+cacheUnlinkUse(LRUCache *cache, LRUCacheEntry *entry)
+{
+	if (entry->newer != NULL)
+		entry->newer->older = entry->older;
+	else
+		cache->newest = entry->older;
+
+	if (entry->older != NULL)
+		entry->older->newer = entry->newer;
+	else
+		cache->oldest = entry->newer;
+}
+
+/** put an entry at the most recently used end of the list */
+static void
+cacheLinkNewest(LRUCache *cache, LRUCacheEntry *entry)
+{
+	entry->newer = NULL;
+	entry->older = cache->newest;
+	if (cache->newest != NULL)
+		cache->newest->newer = entry;
+	else
+		cache->oldest = entry;
+	cache->newest = entry;
+}
+
+/**
+ * Take the entry that *link points at out of the cache, hand its
+ * pair to the user and put the entry back on the unused list
+ */
+static void
+cacheDropEntry(LRUCache *cache, GenericListNode **link)
+{
+	LRUCacheEntry *entry = (LRUCacheEntry *) *link;
+
+	*link = entry->node.next;
+	cacheUnlinkUse(cache, entry);
+	cache->count--;
+
+	entry->node.next = NULL;
+	if (cache->useraction != NULL)
+		(*cache->useraction)(&entry->node, cache->userdata);
+
+	entry->older = cache->unused;
+	cache->unused = entry;
+}
+
+void *
+lstCacheGet(LRUCache *cache, const void *key)
+{
+	unsigned long hash = (*cache->hash)(key);
+	LRUCacheEntry *entry;
+
+	entry = (LRUCacheEntry *) *cacheFindLink(cache, key, hash);
+	if (entry == NULL) {
+		cache->nMisses++;
+		return NULL;
+	}
+
+	cache->nHits++;
+	if (entry != cache->newest) {
+		cacheUnlinkUse(cache, entry);
+		cacheLinkNewest(cache, entry);
+	}
+	return entry->node.data;
+}
+
+void
+lstCachePut(LRUCache *cache, void *key, void *data)
+{
+	unsigned long hash = (*cache->hash)(key);
+	GenericListNode **link;
+	LRUCacheEntry *entry;
+
+	/** an old pair with the same key is replaced outright */
+	link = cacheFindLink(cache, key, hash);
+	if (*link != NULL)
+		cacheDropEntry(cache, link);
+
+	/** otherwise if we are full, make room by evicting the oldest */
+	if (cache->unused == NULL) {
+		entry = cache->oldest;
+		link = cacheFindLink(cache, entry->key, entry->hash);
+		cacheDropEntry(cache, link);
+		cache->nEvictions++;
+	}
+
+	entry = cache->unused;
+	cache->unused = entry->older;
+
+	entry->key = key;
+	entry->hash = hash;
+	entry->node.data = data;
+
+	link = &cache->buckets[hash & cache->bucketMask];
+	entry->node.next = *link;
+	*link = &entry->node;
+
+	cacheLinkNewest(cache, entry);
+	cache->count++;
+}
+
+int
+lstCacheRemove(LRUCache *cache, const void *key)
+{
+	GenericListNode **link;
+
+	link = cacheFindLink(cache, key, (*cache->hash)(key));
+	if (*link == NULL)
+		return 0;
+
+	cacheDropEntry(cache, link);
+	return 1;
+}
+
+int
+lstCacheLength(const LRUCache *cache)
+{
+	return cache->count;
+}
+
+void *
+lstCacheKey(GenericListNode *node)
+{
+	return ((LRUCacheEntry *) node)->key;
+}
+
+/**
+ * FNV-1a -- one xor and one multiply per character
+ */
+unsigned long
+lstCacheHashString(const void *key)
+{
+	const unsigned char *s = (const unsigned char *) key;
+	unsigned long hash = 2166136261UL;
+
+	while (*s != '\0') {
+		hash ^= *s++;
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+void
+lstCacheDestroy(LRUCache *cache)
+{
+	LRUCacheEntry *entry;
+
+	/** hand the pairs over from the least recently used up */
+	for (entry = cache->oldest; entry != NULL; entry = entry->newer) {
+		entry->node.next = NULL;
+		if (cache->useraction != NULL)
+			(*cache->useraction)(&entry->node, cache->userdata);
+	}
+
+	free(cache->entries);
+	free(cache->buckets);
+	cache->entries = cache->unused = cache->newest = cache->oldest = NULL;
+	cache->buckets = NULL;
+	cache->count = 0;
+}
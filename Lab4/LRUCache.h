@@ -0,0 +1,96 @@
+/**
+ * Header file for a least recently used (LRU) cache of generic payloads.
+ *
+ * The cache holds at most a fixed number of key/data pairs.  Looking
+ * a key up, adding a pair and throwing out the pair that has gone
+ * unused for the longest all take constant time: the entries are
+ * kept on a doubly linked list in order of use, and a hash table
+ * finds the entry for a key without walking that list.
+ *
+ * All of the entries are allocated in one block when the cache is
+ * set up and recycled from then on, so the memory the cache itself
+ * uses never grows.
+ *
+ * Each entry starts with a GenericListNode whose "data" is the
+ * cached payload (its "next" chains the entries in a hash bucket),
+ * so a pair that is thrown out can be handed to a useraction
+ * callback just like those given to lstDestroyList().  Every pair
+ * put into the cache is handed to that callback exactly once: when
+ * it is evicted, replaced, removed or the cache is destroyed.
+ */
+
+#ifndef __LRU_CACHE_HEADER__
+#define __LRU_CACHE_HEADER__
+
+#include "LLGeneric.h"
+
+/**
+ ** TYPE DEFINITIONS
+ **/
+
+typedef struct LRUCacheEntry {
+	GenericListNode node;			/* must be first -- see lstCacheKey() */
+	struct LRUCacheEntry *newer;	/* towards the most recently used */
+	struct LRUCacheEntry *older;	/* towards the least recently used */
+	void *key;
+	unsigned long hash;
+} LRUCacheEntry;
+
+typedef struct LRUCache {
+	LRUCacheEntry *entries;		/* all capacity entries, in one block */
+	LRUCacheEntry *unused;		/* entries not holding a pair, linked through older */
+	GenericListNode **buckets;
+	unsigned long bucketMask;	/* the number of buckets is a power of two */
+
+	LRUCacheEntry *newest;
+	LRUCacheEntry *oldest;
+	int count;
+	int capacity;
+
+	unsigned long (*hash)(const void *key);
+	int (*comparator)(const void *key1, const void *key2);
+	void (*useraction)(GenericListNode *, void *);
+	void *userdata;
+
+	/** how the cache has been doing */
+	unsigned long long nHits;
+	unsigned long long nMisses;
+	unsigned long long nEvictions;
+} LRUCache;
+
+/**
+ ** FUNCTION PROTOTYPES
+ **/
+
+/* set up an empty cache for up to capacity pairs, returning -1 if out of memory */
+int lstCacheInit(
+		LRUCache *cache,
+		int capacity,
+		unsigned long (*hash)(const void *key),
+		int (*comparator)(const void *key1, const void *key2),
+		void (*useraction)(GenericListNode *, void *),
+		void *userdata
+	);
+
+/* the data cached for key (making it the most recently used), or NULL */
+void *lstCacheGet(LRUCache *cache, const void *key);
+
+/* cache data under key, evicting the least recently used pair if full */
+void lstCachePut(LRUCache *cache, void *key, void *data);
+
+/* drop the pair for key, returning 1 if there was one */
+int lstCacheRemove(LRUCache *cache, const void *key);
+
+/* the number of pairs in the cache */
+int lstCacheLength(const LRUCache *cache);
+
+/* the key of a pair handed to the useraction callback */
+void *lstCacheKey(GenericListNode *node);
+
+/* a hash function for keys that are strings */
+unsigned long lstCacheHashString(const void *key);
+
+/* hand every pair to the useraction callback, then free the cache */
+void lstCacheDestroy(LRUCache *cache);
+
+#endif /* __LRU_CACHE_HEADER__ */
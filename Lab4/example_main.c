@@ -7,6 +7,7 @@
 #include <errno.h>
 
 #include "LLGeneric.h"
+#include "LLInstrument.h"
 
 /** define the maximum length of a line that we can read */
 #define	LINE_BUFFER_SIZE	1024
@@ -82,17 +83,38 @@ doListActivities(GenericListNode *list)
 static GenericListNode *loadListWithLinesFromFile(const char *filename);
 static void cleanupList(GenericListNode *list);
 
+/**
+ * Comparator for sorting our list of strings -- the library gives
+ * us the "data" pointers of two nodes, which we know are strings
+ */
+static int
+compareLines(const void *vLineA, const void *vLineB)
+{
+	return strcmp((const char *) vLineA, (const char *) vLineB);
+}
+
 /**
  * Program mainline
+ *
+ * The "-S" flag sorts the lines of the files that follow it
+ * before they are printed.
  */
 int
 main(int argc, char **argv)
 {
 	GenericListNode *list = NULL;
+	int sortLines = 0;
 	int i;
 
+	/** if the library is instrumented, report what it counted */
+	lstInstrumentDumpAtExit();
+
 	for (i = 1; i < argc; i++) {
 		if (argv[i][0] == '-') {
+			if (strcmp(argv[i], "-S") == 0) {
+				sortLines = 1;
+				continue;
+			}
 			fprintf(stderr, "Error: unknown flag '%s'\n", argv[i]);
 			return -1;
 		} else {
@@ -103,6 +125,9 @@ main(int argc, char **argv)
 				return -1;
 			}
 
+			if (sortLines)
+				list = lstSort(list, compareLines);
+
 			// do all the work with this list (code is above)
 			doListActivities(list);
 
@@ -133,9 +158,11 @@ loadListWithLinesFromFile(const char *filename)
 {
 	char linebuffer[LINE_BUFFER_SIZE];
 	FILE *ifp = NULL;
-	GenericListNode *headOfGenericLinkedList = NULL;
+	GenericList genericLinkedList;
 	GenericListNode *newNode = NULL;
 
+	lstInitList(&genericLinkedList);
+
 	ifp = fopen(filename, "r");
 	if (ifp == NULL) {
 		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
@@ -149,14 +176,14 @@ loadListWithLinesFromFile(const char *filename)
 		/* create a node, giving an allocated copy of the input line */
 		newNode = lstCreateNode(strdup(linebuffer));
 
-		/* append this new node to the list it do the list */
-		headOfGenericLinkedList = lstAppend(
-				headOfGenericLinkedList, newNode);
+		/* append this new node to the list -- the handle keeps
+		 * track of the tail so this does not walk the list */
+		lstListAppend(&genericLinkedList, newNode);
 	}
 
 
 	fclose(ifp);
-	return headOfGenericLinkedList;
+	return genericLinkedList.head;
 }
 
 static void
@@ -5,61 +5,35 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sched.h>	/* for sched_yield() */
 
 #include "LLGeneric.h"
+#include "LLNodePool.h"
+#include "LLQueue.h"
+#include "LLSkipList.h"
+#include "LRUCache.h"
+#include "LLUnrolled.h"
+#include "LLParallel.h"
+#include "LLLineMap.h"
+#include "LLLineStats.h"
+#include "LLInstrument.h"
+
+/** struct maxData and myFindLongestStringNode(), shared with template_main.cpp */
+#include "longest_callback.h"
 
 /** define the maximum length of a line that we can read */
 #define	LINE_BUFFER_SIZE	1024
 
 /**
- * We can use this as our "user data" to help us calculate the maximum
- * length string
- *
- * Add anything else to this structure that you wish
+ * When the lines are memory mapped we don't have strings to point
+ * at, so we remember which line was the longest instead
  */
-struct maxData {
+struct lineMapMaxData {
 	size_t maxLenSoFar;
-	char *maxStringSoFar;
+	int maxIndexSoFar;
 };
 
-/**
- * our "user function" or "callback" for printing.
- *
- * We know what "void *userdata" is going to be because it is
- * simply what we pass in at the call below, so it is safe to
- * cast back to a FILE * as that is what we passed it.
- *
- * This is called a "callback" as it "call back into" our own
- * code from within a generic routine.
- */
-int myFindLongestStringNode(GenericListNode *node, int index, void *userdata)
-{
-	/**
-	 * Add more code here.  You will need to:
-	 * - convert the GenericListNode payload in the field "data" to your
-	 *   known (char *) type
-	 * - conver the (void *) userdata into your known (struct maxData *)
-	 *   type
-	 * - use the fact that you can examine and store the values provided
-	 *   through the userdata to see what has been calculated by earlier
-	 *   calls to this function and update based on what you see here,
-	 *   in order to determine what the longest string is in the whole
-	 *   set of nodes.
-	 */
-
-	// test to see if the current string is longer than the stored string
-	if (strlen((char *)(node->data)) > ((struct maxData *)userdata)->maxLenSoFar)
-	{
-		// set the new length
-		((struct maxData *)userdata)->maxLenSoFar = strlen((char *)(node->data));
-
-		// set the string this came from
-		((struct maxData *)userdata)->maxStringSoFar = (char *)(node->data);
-	}
-
-	return 1;
-}
-
 int
 doListActivities(GenericListNode *list)
 {
@@ -89,7 +63,431 @@ doListActivities(GenericListNode *list)
 	return nProcessed;
 }
 
-
+/**
+ * "combine" function for the parallel version below: each thread
+ * worked out the longest string in its own part of the list, and
+ * this merges those answers.  As the parts are combined in list
+ * order, only a strictly longer string replaces the one we have,
+ * exactly as in the callback.
+ */
+void myCombineLongestString(void *into, const void *from)
+{
+	struct maxData *result = (struct maxData *) into;
+	const struct maxData *partial = (const struct maxData *) from;
+
+	if (partial->maxLenSoFar > result->maxLenSoFar) {
+		result->maxLenSoFar = partial->maxLenSoFar;
+		result->maxStringSoFar = partial->maxStringSoFar;
+	}
+}
+
+/**
+ * The same calculation split across nThreads threads, each with
+ * its own copy of the user data structure
+ */
+int
+doParallelListActivities(GenericList *list, int nThreads)
+{
+	struct maxData maxDataPerThread[LST_MAX_THREADS];
+	int nProcessed = 0, t;
+
+	for (t = 0; t < LST_MAX_THREADS; t++) {
+		maxDataPerThread[t].maxLenSoFar = 0;
+		maxDataPerThread[t].maxStringSoFar = NULL;
+	}
+
+	nProcessed = lstPerformParallelAction(
+			list,
+			nThreads,
+			myFindLongestStringNode,
+			(void *) maxDataPerThread,
+			sizeof(struct maxData),
+			myCombineLongestString);
+
+	/** the combined answer ends up in the first structure */
+	printf("The longest string has %ld characters\n",
+			maxDataPerThread[0].maxLenSoFar);
+	printf("The longest string is: %s\n",
+			maxDataPerThread[0].maxStringSoFar);
+
+	return nProcessed;
+}
+
+/**
+ * A batched version of our callback: we are handed several nodes at
+ * once, whose strings have already been asked for from memory
+ */
+int myFindLongestStringBatch(GenericListNode **nodes, int nNodes,
+		int firstIndex, void *userdata)
+{
+	struct maxData *ourMaxData = (struct maxData *) userdata;
+	size_t len;
+	int i;
+
+	for (i = 0; i < nNodes; i++) {
+		len = strlen((char *) nodes[i]->data);
+		if (len > ourMaxData->maxLenSoFar) {
+			ourMaxData->maxLenSoFar = len;
+			ourMaxData->maxStringSoFar = (char *) nodes[i]->data;
+		}
+	}
+
+	(void) firstIndex;
+	return 1;
+}
+
+/**
+ * The same calculation done a batch of nodes at a time
+ */
+int
+doBatchedListActivities(GenericListNode *list)
+{
+	struct maxData maxDataWorkingStruct;
+	int nProcessed = 0;
+
+	maxDataWorkingStruct.maxLenSoFar = 0;
+	maxDataWorkingStruct.maxStringSoFar = NULL;
+
+	nProcessed = lstPerformBatchedAction(
+			list,
+			LST_MAX_BATCH_SIZE / 4,
+			myFindLongestStringBatch,
+			(void *) &maxDataWorkingStruct);
+
+	printf("The longest string has %ld characters\n",
+			maxDataWorkingStruct.maxLenSoFar);
+	printf("The longest string is: %s\n",
+			maxDataWorkingStruct.maxStringSoFar);
+
+	return nProcessed;
+}
+
+/**
+ * Callback for the memory mapped lines: the data is a reference to
+ * the line, which already knows its length, so we only need to ask
+ * for the line as a string once we know which one is the longest
+ */
+int myFindLongestLineInMap(GenericListNode *node, int index, void *userdata)
+{
+	LineMapLine *line = (LineMapLine *) node->data;
+	struct lineMapMaxData *ourMaxData = (struct lineMapMaxData *) userdata;
+
+	if (line->length > ourMaxData->maxLenSoFar) {
+		ourMaxData->maxLenSoFar = line->length;
+		ourMaxData->maxIndexSoFar = index;
+	}
+
+	return 1;
+}
+
+/**
+ * The same calculation on the lines of a memory mapped file
+ */
+int
+doLineMapActivities(LineMap *map)
+{
+	struct lineMapMaxData maxDataWorkingStruct;
+	int nProcessed = 0;
+
+	maxDataWorkingStruct.maxLenSoFar = 0;
+	maxDataWorkingStruct.maxIndexSoFar = -1;
+
+	nProcessed = lstLineMapPerformIterativeAction(
+			map,
+			myFindLongestLineInMap,
+			(void *) &maxDataWorkingStruct);
+
+	printf("The longest string has %ld characters\n",
+			maxDataWorkingStruct.maxLenSoFar);
+	printf("The longest string is: %s\n",
+			lstLineMapGetString(map, maxDataWorkingStruct.maxIndexSoFar));
+
+	return nProcessed;
+}
+
+/**
+ * The same calculation on an unrolled list -- note that the
+ * callback is exactly the same one as above
+ */
+int
+doUnrolledListActivities(UnrolledList *list)
+{
+	struct maxData maxDataWorkingStruct;
+	int nProcessed = 0;
+
+	maxDataWorkingStruct.maxLenSoFar = 0;
+	maxDataWorkingStruct.maxStringSoFar = NULL;
+
+	nProcessed = lstUnrolledPerformIterativeAction(
+			list,
+			myFindLongestStringNode,
+			(void *) &maxDataWorkingStruct);
+
+	printf("The longest string has %ld characters\n",
+			maxDataWorkingStruct.maxLenSoFar);
+	printf("The longest string is: %s\n",
+			maxDataWorkingStruct.maxStringSoFar);
+
+	return nProcessed;
+}
+
+/**
+ * The same answer, plus the number of lines and how their lengths
+ * are spread out, without building anything at all: the file is
+ * streamed through once (see LLLineStats.h)
+ */
+int
+doStreamingActivities(const char *filename, int nThreads)
+{
+	LineStats stats;
+	unsigned long long low;
+	int b;
+
+	if (lstLineStatsFromFile(filename, nThreads, &stats) < 0
+			|| stats.nLines == 0)
+		return -1;
+
+	printf("The longest string has %llu characters (counting its newline)\n",
+			stats.longestLength);
+	printf("The longest string is: ");
+	if (lstLineStatsWriteLongest(filename, &stats, stdout) < 0)
+		return -1;
+	printf("\n");
+
+	printf("There are %llu lines, by length not counting the newline:\n",
+			stats.nLines);
+	for (b = 0; b < LST_LINE_HISTOGRAM_BUCKETS; b++) {
+		if (stats.histogram[b] == 0)
+			continue;
+		low = (b == 0) ? 0 : 1ULL << (b - 1);
+		printf("  %10llu lines of %llu to %llu characters\n",
+				stats.histogram[b], low, (b == 0) ? 0 : 2 * low - 1);
+	}
+
+	return (int) stats.nLines;
+}
+
+
+/** the callback that frees our strings, which is down with the other tools */
+static void deleteStringInGenericNode(GenericListNode *node, void *userdata);
+
+/**
+ * What the reader thread of doQueuedListActivities() works on
+ */
+struct queueReaderData {
+	const char *filename;
+	GenericListQueue *queue;
+	int done;			/* set (atomically) once every line is pushed */
+	int status;
+};
+
+/**
+ * Read each line of the file into a node of its own and push it
+ * onto the queue.  The nodes come from lstCreateNode(), not a pool,
+ * as a pool may only be used by one thread at a time.
+ */
+static void *
+queueReaderThread(void *vData)
+{
+	struct queueReaderData *reader = (struct queueReaderData *) vData;
+	char linebuffer[LINE_BUFFER_SIZE];
+	FILE *ifp = NULL;
+
+	reader->status = 0;
+	ifp = fopen(reader->filename, "r");
+	if (ifp == NULL) {
+		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
+				reader->filename, strerror(errno));
+		reader->status = -1;
+	} else {
+		while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL)
+			lstQueuePush(reader->queue, lstCreateNode(strdup(linebuffer)));
+		fclose(ifp);
+	}
+
+	__atomic_store_n(&reader->done, 1, __ATOMIC_RELEASE);
+	return NULL;
+}
+
+/**
+ * The same answer again, but with the file read on a thread of its
+ * own that hands the lines over through a lock-free queue (see
+ * LLQueue.h), while this thread builds the list from them as they
+ * arrive.  There is only one producer, so the lines stay in order.
+ */
+int
+doQueuedListActivities(const char *filename)
+{
+	struct queueReaderData reader;
+	GenericListQueue queue;
+	GenericList list;
+	pthread_t thread;
+	int done, nMoved, nProcessed;
+
+	lstQueueInit(&queue);
+	lstInitList(&list);
+	reader.filename = filename;
+	reader.queue = &queue;
+	reader.done = 0;
+
+	if (pthread_create(&thread, NULL, queueReaderThread, &reader) != 0)
+		return -1;
+
+	/**
+	 * done is looked at before draining, so that once it is set
+	 * one last drain is sure to pick up every node that was pushed
+	 */
+	do {
+		done = __atomic_load_n(&reader.done, __ATOMIC_ACQUIRE);
+		nMoved = lstQueueDrainToList(&queue, &list, LST_MAX_BATCH_SIZE);
+		if (nMoved == 0 && ! done)
+			sched_yield();
+	} while (nMoved > 0 || ! done);
+	pthread_join(thread, NULL);
+
+	nProcessed = -1;
+	if (reader.status == 0 && list.count > 0)
+		nProcessed = doListActivities(list.head);
+
+	lstDestroyList(list.head, deleteStringInGenericNode, NULL);
+	return nProcessed;
+}
+
+/**
+ * Where the skip list version below keeps the first and last lines
+ * in sorted order
+ */
+struct sortedLineData {
+	char *firstLine;
+	char *lastLine;
+};
+
+static int
+compareLines(const void *line1, const void *line2)
+{
+	return strcmp((const char *) line1, (const char *) line2);
+}
+
+int myNoteFirstAndLastLine(GenericListNode *node, int index, void *userdata)
+{
+	struct sortedLineData *sorted = (struct sortedLineData *) userdata;
+
+	if (index == 0)
+		sorted->firstLine = (char *) node->data;
+	sorted->lastLine = (char *) node->data;
+	return 1;
+}
+
+/**
+ * Load the lines into a skip list kept in sorted order (see
+ * LLSkipList.h).  Each line is looked up before it goes in to count
+ * how many different lines there are, and a walk of the whole range
+ * then finds the first and last of them in order.
+ */
+int
+doSkipListActivities(const char *filename)
+{
+	char linebuffer[LINE_BUFFER_SIZE];
+	struct sortedLineData sorted;
+	SkipList list;
+	FILE *ifp = NULL;
+	char *line;
+	int nDistinct = 0, nProcessed = -1;
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL) {
+		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
+				filename, strerror(errno));
+		return -1;
+	}
+	if (lstSkipInit(&list, compareLines, 2520) < 0) {
+		fclose(ifp);
+		return -1;
+	}
+
+	while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL) {
+		if (lstSkipFind(&list, linebuffer) == NULL)
+			nDistinct++;
+		line = strdup(linebuffer);
+		if (line == NULL || lstSkipInsert(&list, line) < 0) {
+			fprintf(stderr, "Error: out of memory loading '%s'\n", filename);
+			free(line);
+			lstSkipDestroy(&list, deleteStringInGenericNode, NULL);
+			fclose(ifp);
+			return -1;
+		}
+	}
+	fclose(ifp);
+
+	if (lstSkipLength(&list) > 0) {
+		sorted.firstLine = sorted.lastLine = NULL;
+		nProcessed = lstSkipPerformRangeAction(&list, NULL, NULL,
+				myNoteFirstAndLastLine, (void *) &sorted);
+
+		printf("There are %d lines, %d of them different\n",
+				lstSkipLength(&list), nDistinct);
+		printf("The first line in order is: %s\n", sorted.firstLine);
+		printf("The last line in order is: %s\n", sorted.lastLine);
+	}
+
+	lstSkipDestroy(&list, deleteStringInGenericNode, NULL);
+	return nProcessed;
+}
+
+/**
+ * Pass the lines through an LRU cache with room for "capacity" of
+ * them (see LRUCache.h), to see how often a line turns up again
+ * while it is still among the most recently seen ones.  Each line
+ * is both the key and the data of its pair, so the useraction only
+ * has the one string to free.
+ */
+int
+doCacheActivities(const char *filename, int capacity)
+{
+	char linebuffer[LINE_BUFFER_SIZE];
+	LRUCache cache;
+	FILE *ifp = NULL;
+	char *line;
+	int nLines = 0;
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL) {
+		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
+				filename, strerror(errno));
+		return -1;
+	}
+	if (lstCacheInit(&cache, capacity, lstCacheHashString, compareLines,
+				deleteStringInGenericNode, NULL) < 0) {
+		fclose(ifp);
+		return -1;
+	}
+
+	while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL) {
+		nLines++;
+		if (lstCacheGet(&cache, linebuffer) != NULL)
+			continue;
+		line = strdup(linebuffer);
+		if (line == NULL) {
+			fprintf(stderr, "Error: out of memory loading '%s'\n", filename);
+			lstCacheDestroy(&cache);
+			fclose(ifp);
+			return -1;
+		}
+		lstCachePut(&cache, line, line);
+	}
+	fclose(ifp);
+
+	if (nLines > 0) {
+		printf("With room for %d lines, %llu of %d lines were in the cache\n",
+				capacity, cache.nHits, nLines);
+		printf("There were %llu misses and %llu lines were thrown out\n",
+				cache.nMisses, cache.nEvictions);
+	}
+
+	lstCacheDestroy(&cache);
+	return (nLines > 0) ? nLines : -1;
+}
+
 
 /**
  **		Tools provided below here you won't need to edit -- they
@@ -103,38 +501,162 @@ doListActivities(GenericListNode *list)
  ** These are declared static simply because they are only
  ** declared and used within this file.
  **/
-static GenericListNode *loadListWithLinesFromFile(const char *filename);
-static void cleanupList(GenericListNode *list);
+static GenericListNode *loadListWithLinesFromFile(const char *filename,
+		GenericNodePool *pool, GenericList *list);
+static void cleanupList(GenericNodePool *pool, GenericList *list);
+static int loadUnrolledListWithLinesFromFile(const char *filename,
+		UnrolledList *list);
+static void cleanupUnrolledList(UnrolledList *list);
 
 /**
  * Program mainline
+ *
+ * The "-u" flag loads the files that follow it into an unrolled
+ * list instead (see LLUnrolled.h), "-P <n>" processes the lists
+ * of the files that follow it on n threads (see LLParallel.h),
+ * "-b" processes them in batches (see lstPerformBatchedAction()),
+ * "-m" maps the files into memory instead of building a list
+ * at all (see LLLineMap.h), "-s" just streams through them,
+ * also reporting the line count and length histogram (see
+ * LLLineStats.h), "-q" reads them on a thread of their own
+ * that hands the lines over through a queue (see LLQueue.h),
+ * "-k" keeps the lines in sorted order in a skip list (see
+ * LLSkipList.h), and "-c <n>" counts how many lines are seen again
+ * while still in an LRU cache of n lines (see LRUCache.h).
  */
 int
 main(int argc, char **argv)
 {
-	GenericListNode *list = NULL;
+	GenericNodePool nodePool;
+	GenericList list;
+	UnrolledList unrolledList;
+	LineMap lineMap;
+	int useUnrolled = 0, useBatches = 0, useLineMap = 0, useStreaming = 0;
+	int useQueue = 0, useSkipList = 0, cacheCapacity = 0;
+	int nThreads = 1;
+	int loadStatus;
 	int i;
 
+	/** all of the nodes for every file come from this one pool */
+	lstPoolInit(&nodePool, 0);
+
+	/** if the library is instrumented, report what it counted */
+	lstInstrumentDumpAtExit();
+
 	for (i = 1; i < argc; i++) {
 		if (argv[i][0] == '-') {
+			if (strcmp(argv[i], "-u") == 0) {
+				useUnrolled = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-b") == 0) {
+				useBatches = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-m") == 0) {
+				useLineMap = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-s") == 0) {
+				useStreaming = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-q") == 0) {
+				useQueue = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-k") == 0) {
+				useSkipList = 1;
+				continue;
+			}
+			if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+				cacheCapacity = atoi(argv[++i]);
+				if (cacheCapacity >= 1)
+					continue;
+				fprintf(stderr, "Error: bad cache size '%s'\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+			if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+				nThreads = atoi(argv[++i]);
+				if (nThreads >= 1)
+					continue;
+				fprintf(stderr, "Error: bad thread count '%s'\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
 			fprintf(stderr, "Error: unknown flag '%s'\n", argv[i]);
+			lstPoolDestroy(&nodePool);
 			return -1;
-		} else {
-			list = loadListWithLinesFromFile(argv[i]);
+		} else if (useStreaming) {
+			errno = 0;
+			if (doStreamingActivities(argv[i], nThreads) < 0) {
+				fprintf(stderr, "Error: reading '%s' failed : %s\n", argv[i],
+						(errno != 0) ? strerror(errno) : "no lines");
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+		} else if (cacheCapacity > 0) {
+			if (doCacheActivities(argv[i], cacheCapacity) < 0) {
+				fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+		} else if (useSkipList) {
+			if (doSkipListActivities(argv[i]) < 0) {
+				fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+		} else if (useQueue) {
+			if (doQueuedListActivities(argv[i]) < 0) {
+				fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+		} else if (useLineMap) {
+			/** a failed load leaves the map empty too, so check it first */
+			loadStatus = lstLineMapLoad(&lineMap, argv[i]);
+			if (loadStatus < 0 || lstLineMapLength(&lineMap) == 0) {
+				fprintf(stderr, "Error: loading '%s' failed : %s\n", argv[i],
+						(loadStatus < 0) ? strerror(errno) : "no lines");
+				lstLineMapDestroy(&lineMap);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
 
-			if (list == NULL) {
+			doLineMapActivities(&lineMap);
+			lstLineMapDestroy(&lineMap);
+		} else if (useUnrolled) {
+			if (loadUnrolledListWithLinesFromFile(argv[i], &unrolledList) < 0) {
 				fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+				lstPoolDestroy(&nodePool);
+				return -1;
+			}
+
+			doUnrolledListActivities(&unrolledList);
+			cleanupUnrolledList(&unrolledList);
+		} else {
+			if (loadListWithLinesFromFile(argv[i], &nodePool, &list) == NULL) {
+				fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+				lstPoolDestroy(&nodePool);
 				return -1;
 			}
 
 			// do all the work with this list (code is above)
-			doListActivities(list);
+			if (nThreads > 1)
+				doParallelListActivities(&list, nThreads);
+			else if (useBatches)
+				doBatchedListActivities(list.head);
+			else
+				doListActivities(list.head);
 
 			// get rid of the list memory (code is below)
-			cleanupList(list);
+			cleanupList(&nodePool, &list);
 		}
 	}
 
+	lstPoolDestroy(&nodePool);
 	return 0;
 }
 
@@ -151,15 +673,20 @@ main(int argc, char **argv)
  * ** This is where we are defining what the type is of our
  * ** "generic" (void *) data by supplying it with a string
  * ** that we have allocated using strdup() (internally, malloc())
+ *
+ * The nodes come from the given pool, so they end up next to each
+ * other in memory in the order of the lines in the file.
  */
 static GenericListNode *
-loadListWithLinesFromFile(const char *filename)
+loadListWithLinesFromFile(const char *filename,
+		GenericNodePool *pool, GenericList *genericLinkedList)
 {
 	char linebuffer[LINE_BUFFER_SIZE];
 	FILE *ifp = NULL;
-	GenericListNode *headOfGenericLinkedList = NULL;
 	GenericListNode *newNode = NULL;
 
+	lstInitList(genericLinkedList);
+
 	ifp = fopen(filename, "r");
 	if (ifp == NULL) {
 		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
@@ -171,16 +698,16 @@ loadListWithLinesFromFile(const char *filename)
 	while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL) {
 
 		/* create a node, giving an allocated copy of the input line */
-		newNode = lstCreateNode(strdup(linebuffer));
+		newNode = lstPoolCreateNode(pool, strdup(linebuffer));
 
-		/* append this new node to the list it do the list */
-		headOfGenericLinkedList = lstAppend(
-				headOfGenericLinkedList, newNode);
+		/* append this new node to the list -- the handle keeps
+		 * track of the tail so this does not walk the list */
+		lstListAppend(genericLinkedList, newNode);
 	}
 
 
 	fclose(ifp);
-	return headOfGenericLinkedList;
+	return genericLinkedList->head;
 }
 
 static void
@@ -195,9 +722,48 @@ deleteStringInGenericNode(GenericListNode *node, void *userdata)
 }
 
 static void
-cleanupList(GenericListNode *list)
+cleanupList(GenericNodePool *pool, GenericList *list)
 {
 	// use our callback just above to delete the strings while
-	// cleaning up the list
-	lstDestroyList(list, deleteStringInGenericNode, NULL);
+	// giving the nodes back to the pool in one go
+	lstPoolReleaseList(pool, list, deleteStringInGenericNode, NULL);
+}
+
+/**
+ * As loadListWithLinesFromFile(), but into an unrolled list.
+ * Returns -1 on failure (or if there are no lines, as above).
+ */
+static int
+loadUnrolledListWithLinesFromFile(const char *filename, UnrolledList *list)
+{
+	char linebuffer[LINE_BUFFER_SIZE];
+	FILE *ifp = NULL;
+
+	lstUnrolledInit(list);
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL) {
+		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
+				filename, strerror(errno));
+		return -1;
+	}
+
+	/** process each line from the file */
+	while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL) {
+		if (lstUnrolledAppend(list, strdup(linebuffer)) < 0) {
+			fprintf(stderr, "Error: out of memory loading '%s'\n", filename);
+			fclose(ifp);
+			cleanupUnrolledList(list);
+			return -1;
+		}
+	}
+
+	fclose(ifp);
+	return (lstUnrolledLength(list) > 0) ? 0 : -1;
+}
+
+static void
+cleanupUnrolledList(UnrolledList *list)
+{
+	lstUnrolledDestroy(list, deleteStringInGenericNode, NULL);
 }
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "longest_callback.h"	/* include our structure and prototype */
+
+/**
+ * our "user function" or "callback" for printing.
+ *
+ * We know what "void *userdata" is going to be because it is
+ * simply what we pass in at the call below, so it is safe to
+ * cast back to a FILE * as that is what we passed it.
+ *
+ * This is called a "callback" as it "call back into" our own
+ * code from within a generic routine.
+ */
+int myFindLongestStringNode(GenericListNode *node, int index, void *userdata)
+{
+	/**
+	 * Add more code here.  You will need to:
+	 * - convert the GenericListNode payload in the field "data" to your
+	 *   known (char *) type
+	 * - conver the (void *) userdata into your known (struct maxData *)
+	 *   type
+	 * - use the fact that you can examine and store the values provided
+	 *   through the userdata to see what has been calculated by earlier
+	 *   calls to this function and update based on what you see here,
+	 *   in order to determine what the longest string is in the whole
+	 *   set of nodes.
+	 */
+
+	size_t len = strlen((char *)(node->data));
+
+	// test to see if the current string is longer than the stored string
+	if (len > ((struct maxData *)userdata)->maxLenSoFar)
+	{
+		// set the new length
+		((struct maxData *)userdata)->maxLenSoFar = len;
+
+		// set the string this came from
+		((struct maxData *)userdata)->maxStringSoFar = (char *)(node->data);
+	}
+
+	return 1;
+}
@@ -0,0 +1,30 @@
+/**
+ * Header file for the callback that finds the longest string in a
+ * list of strings.
+ *
+ * It lives in a file of its own so that lab4_main.c and the C++
+ * template_main.cpp run the very same callback.
+ */
+
+#ifndef __LONGEST_CALLBACK_HEADER__
+#define __LONGEST_CALLBACK_HEADER__
+
+#include <stddef.h>	/* for size_t */
+
+#include "LLGeneric.h"
+
+/**
+ * We can use this as our "user data" to help us calculate the maximum
+ * length string
+ *
+ * Add anything else to this structure that you wish
+ */
+struct maxData {
+	size_t maxLenSoFar;
+	char *maxStringSoFar;
+};
+
+/* the iteration callback: userdata is a (struct maxData *) */
+int myFindLongestStringNode(GenericListNode *node, int index, void *userdata);
+
+#endif /* __LONGEST_CALLBACK_HEADER__ */
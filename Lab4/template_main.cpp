@@ -0,0 +1,137 @@
+/**
+ *  The longest string calculation again, this time using the C++
+ *  template list in LLTemplate.hpp.
+ *
+ *  By default the lines are kept as std::string payloads inside the
+ *  nodes and a lambda finds the longest.  With "-c" the lines are
+ *  strdup()ed into a List<char *> instead and the very same callback
+ *  as lab4_main.c uses (from longest_callback.c) is run over it, to
+ *  show that existing lstPerformIterativeAction() code keeps working.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <string>
+
+#include "LLTemplate.hpp"
+
+/** the very same callback (and its user data) as lab4_main.c uses */
+extern "C" {
+#include "longest_callback.h"
+}
+
+/** define the maximum length of a line that we can read */
+#define	LINE_BUFFER_SIZE	1024
+
+/**
+ * Read each line of the file and hand it to addLine()
+ */
+template <typename AddLine>
+static int
+loadLinesFromFile(const char *filename, AddLine &&addLine)
+{
+	char linebuffer[LINE_BUFFER_SIZE];
+	FILE *ifp;
+
+	ifp = fopen(filename, "r");
+	if (ifp == NULL) {
+		fprintf(stderr, "Error: Cannot open input file '%s' : %s\n",
+				filename, strerror(errno));
+		return -1;
+	}
+
+	while (fgets(linebuffer, LINE_BUFFER_SIZE, ifp) != NULL)
+		addLine(linebuffer);
+
+	fclose(ifp);
+	return 0;
+}
+
+/**
+ * The lines live inside the nodes, and the lambda is inlined into
+ * the walk along the list
+ */
+static int
+doTemplateListActivities(const char *filename)
+{
+	lst::List<std::string, lst::SlabAllocator<std::string> > list;
+	const std::string *longest = nullptr;
+
+	if (loadLinesFromFile(filename,
+			[&](const char *line) { list.emplaceBack(line); }) < 0
+			|| list.empty())
+		return -1;
+
+	list.performIterativeAction(
+			[&](const std::string &line, int) {
+				if (longest == nullptr || line.size() > longest->size())
+					longest = &line;
+			});
+
+	printf("The longest string has %ld characters\n", (long) longest->size());
+	printf("The longest string is: %s\n", longest->c_str());
+
+	return list.length();
+}
+
+/**
+ * A list of strings just like the one lab4_main.c builds, processed
+ * with the C style callback
+ */
+static int
+doCallbackListActivities(const char *filename)
+{
+	lst::List<char *> list;
+	struct maxData maxDataWorkingStruct;
+	int nProcessed;
+
+	if (loadLinesFromFile(filename,
+			[&](const char *line) { list.append(strdup(line)); }) < 0
+			|| list.empty())
+		return -1;
+
+	maxDataWorkingStruct.maxLenSoFar = 0;
+	maxDataWorkingStruct.maxStringSoFar = NULL;
+
+	nProcessed = list.performIterativeAction(
+			myFindLongestStringNode,
+			(void *) &maxDataWorkingStruct);
+
+	printf("The longest string has %ld characters\n",
+			(long) maxDataWorkingStruct.maxLenSoFar);
+	printf("The longest string is: %s\n",
+			maxDataWorkingStruct.maxStringSoFar);
+
+	list.destroy([](char *line) { free(line); });
+	return nProcessed;
+}
+
+/**
+ * Program mainline
+ */
+int
+main(int argc, char **argv)
+{
+	int useCallback = 0;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (argv[i][0] == '-') {
+			if (strcmp(argv[i], "-c") == 0) {
+				useCallback = 1;
+				continue;
+			}
+			fprintf(stderr, "Error: unknown flag '%s'\n", argv[i]);
+			return -1;
+		}
+
+		if ((useCallback ? doCallbackListActivities(argv[i])
+				: doTemplateListActivities(argv[i])) < 0) {
+			fprintf(stderr, "Error: loading '%s' failed\n", argv[i]);
+			return -1;
+		}
+	}
+
+	return 0;
+}
@@ -1,6 +1,10 @@
 #ifndef	__FRUIT_DATASTRUCTURE_HEADER__
 #define	__FRUIT_DATASTRUCTURE_HEADER__
 
+#include "bsearch-eytzinger.h"
+#include "bsearch-prefix.h"
+#include "bsearch-ktree.h"
+
 typedef struct FruitData {
 	char *common;
 	char *latin;
@@ -17,4 +21,46 @@ void printDataArray(const FruitData *dataArray, int datalength);
 void searchInCommonName(const FruitData *fruitDataArray, int nFruits, char *key);
 void searchInLatinName(FruitData * const *fruitDataPointers, int nFruits, char *key);
 
+/* quiet versions of the above using bsearch-fast.h */
+void searchInCommonNameFast(const FruitData *fruitDataArray, int nFruits, char *key);
+void searchInLatinNameFast(FruitData * const *fruitDataPointers, int nFruits, char *key);
+
+/* the same, searching an index built once over the data (see bsearch-eytzinger.h) */
+void searchInCommonNameEytzinger(const EytzingerIndex *index, char *key);
+void searchInLatinNameEytzinger(const EytzingerIndex *index, char *key);
+
+/* build an index of key prefixes once (see bsearch-prefix.h), returning -1 if out of memory */
+int buildCommonNamePrefixIndex(PrefixIndex *index,
+		const FruitData *fruitDataArray, int nFruits);
+int buildLatinNamePrefixIndex(PrefixIndex *index,
+		FruitData * const *fruitDataPointers, int nFruits);
+
+/* the same, searching such an index; the array is only used for the IDs */
+void searchInCommonNamePrefix(const PrefixIndex *index,
+		const FruitData *fruitDataArray, char *key);
+void searchInLatinNamePrefix(const PrefixIndex *index,
+		FruitData * const *fruitDataPointers, char *key);
+
+/* the same, with comparators compiled into the search (see bsearch-template.hpp) */
+void searchInCommonNameTemplate(const FruitData *fruitDataArray, int nFruits, char *key);
+void searchInLatinNameTemplate(FruitData * const *fruitDataPointers, int nFruits, char *key);
+
+/* build a tree of 16 key nodes on latinIndex once (see bsearch-ktree.h) */
+int buildLatinIndexKaryTree(KaryTree *tree,
+		FruitData * const *fruitDataPointers, int nFruits);
+
+/* search on latinIndex using such a tree; the array is only used for the IDs */
+void searchInLatinIndexKaryTree(const KaryTree *tree,
+		FruitData * const *fruitDataPointers, int key);
+
+/* find every name starting with key (see bsearch-range.h) */
+void searchInCommonNameRange(const FruitData *fruitDataArray, int nFruits, char *key);
+void searchInLatinNameRange(FruitData * const *fruitDataPointers, int nFruits, char *key);
+
+/* the same for many keys at once (see bsearch-batch.h) */
+void searchInCommonNameBatch(const FruitData *fruitDataArray, int nFruits,
+		char **keys, int nKeys);
+void searchInLatinNameBatch(FruitData * const *fruitDataPointers, int nFruits,
+		char **keys, int nKeys);
+
 #endif	/* __FRUIT_DATASTRUCTURE_HEADER__ */
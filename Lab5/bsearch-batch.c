@@ -0,0 +1,88 @@
+/*
+ * Binary search for a batch of keys at once, with
+ * groups of searches advancing through the array
+ * together so that their cache misses overlap
+ */
+#include <stdio.h>
+#include "bsearch-batch.h"
+
+/** ask for memory to be brought into cache ahead of when we need it */
+#if defined(__GNUC__)
+#define	BSEARCH_PREFETCH(address)	__builtin_prefetch(address)
+#else
+#define	BSEARCH_PREFETCH(address)	((void) (address))
+#endif
+
+/**
+ * Search for up to BSEARCH_BATCH_GROUP keys in lockstep
+ */
+static void
+searchgroup(
+		const void * const *keys, int nKeys,
+		const char *cData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		void **results
+		)
+{
+	const char *base[BSEARCH_BATCH_GROUP];
+	int len = n;
+	int half, nextHalf, c, j;
+
+	for (j = 0; j < nKeys; j++) {
+		base[j] = cData;
+		BSEARCH_PREFETCH(&cData[(n / 2) * tilesize]);
+	}
+
+	/**
+	 * Each step narrows every search to len - half elements, so we
+	 * know where each one will look next as soon as it has moved
+	 */
+	while (len > 1) {
+		half = len / 2;
+		nextHalf = (len - half) / 2;
+
+		for (j = 0; j < nKeys; j++) {
+			c = (*comparator)(keys[j], &base[j][half * tilesize]);
+			base[j] += (c > 0) * half * tilesize;
+			BSEARCH_PREFETCH(&base[j][nextHalf * tilesize]);
+		}
+		len -= half;
+	}
+
+	/** as in binarysearchfast(): the key can only be at the lower bound */
+	for (j = 0; j < nKeys; j++) {
+		c = (*comparator)(keys[j], base[j]);
+		if (c > 0) {
+			base[j] += tilesize;
+			if (base[j] == &cData[n * tilesize])
+				c = -1;
+			else
+				c = (*comparator)(keys[j], base[j]);
+		}
+		results[j] = (c == 0) ? (void *) base[j] : NULL;
+	}
+}
+
+void
+binarysearchbatch(
+		const void * const *keys, int nKeys,
+		const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		void **results
+		)
+{
+	int i, nInGroup;
+
+	if (n <= 0) {
+		for (i = 0; i < nKeys; i++)
+			results[i] = NULL;
+		return;
+	}
+
+	for (i = 0; i < nKeys; i += nInGroup) {
+		nInGroup = (nKeys - i < BSEARCH_BATCH_GROUP)
+				? nKeys - i : BSEARCH_BATCH_GROUP;
+		searchgroup(&keys[i], nInGroup, (const char *) vData, n, tilesize,
+				comparator, &results[i]);
+	}
+}
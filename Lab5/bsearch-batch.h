@@ -0,0 +1,36 @@
+#ifndef	__BINARY_SEARCH_BATCH_HEADER__
+#define	__BINARY_SEARCH_BATCH_HEADER__
+
+/**
+ * Look up many keys in the same sorted array at once.
+ *
+ * Each step of a binary search of a large array is a cache miss,
+ * and a single search cannot start its next step until the miss is
+ * over.  Searches for different keys don't depend on each other,
+ * though, so here a group of BSEARCH_BATCH_GROUP of them are taken
+ * down the array together, one step each in turn.  Each search
+ * prefetches its next element as it takes a step, and by the time
+ * we come round to it again the other searches in the group have
+ * had their turns, so its miss has been overlapped with theirs.
+ *
+ * As all of the searches are over the same n elements, they all
+ * take the same (branchless) number of steps, as in bsearch-fast.c.
+ */
+
+/** how many searches are taken along together */
+#define	BSEARCH_BATCH_GROUP		16
+
+/*
+ * Search for each of keys[0..nKeys-1] (each handed to the comparator
+ * as it is, just like the key given to binarysearch()), setting
+ * results[i] to the element equal to keys[i] or NULL
+ */
+void
+binarysearchbatch(
+		const void * const *keys, int nKeys,
+		const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		void **results
+		);
+
+#endif	/* __BINARY_SEARCH_BATCH_HEADER__ */
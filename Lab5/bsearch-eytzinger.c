@@ -0,0 +1,127 @@
+/*
+ * Binary search over a copy of a sorted array laid
+ * out in breadth first (Eytzinger) order
+ */
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+#include <string.h> /* for memcpy() */
+
+#include "bsearch-eytzinger.h"
+
+/** ask for memory to be brought into cache ahead of when we need it */
+#if defined(__GNUC__)
+#define	EYTZINGER_PREFETCH(address)	__builtin_prefetch(address)
+#else
+#define	EYTZINGER_PREFETCH(address)	((void) (address))
+#endif
+
+#define	CACHE_LINE_SIZE				64
+
+/** prefetch as far ahead as we can while fetching at most this much */
+#define	EYTZINGER_PREFETCH_BYTES	(4 * CACHE_LINE_SIZE)
+
+
+/**
+ * Fill the tree in order: the left subtree of slot k holds all of
+ * the elements before the one in slot k, so visiting the slots in
+ * order (left, self, right) hands them out in sorted order
+ */
+static int
+eytzingerFill(EytzingerIndex *index, const char *cData, int nextSorted, int k)
+{
+	if (k > index->n)
+		return nextSorted;
+
+	nextSorted = eytzingerFill(index, cData, nextSorted, 2 * k);
+
+	memcpy(&index->tree[k * index->tilesize],
+			&cData[nextSorted * index->tilesize], index->tilesize);
+	index->sortedIndex[k] = nextSorted++;
+
+	return eytzingerFill(index, cData, nextSorted, 2 * k + 1);
+}
+
+int
+eytzingerBuild(EytzingerIndex *index, const void *vData, int n, int tilesize)
+{
+	index->n = (n > 0) ? n : 0;
+	index->tilesize = tilesize;
+
+	/** the 2^d descendants d levels down span 2^d tiles */
+	index->prefetchLevels = 1;
+	while ((2 << index->prefetchLevels) * tilesize <= EYTZINGER_PREFETCH_BYTES)
+		index->prefetchLevels++;
+
+	/** line the tree up with cache lines, so a block of descendants
+	 ** is split across as few lines as possible */
+	index->tree = (char *) aligned_alloc(CACHE_LINE_SIZE,
+			(((index->n + 1) * tilesize + CACHE_LINE_SIZE - 1)
+					/ CACHE_LINE_SIZE) * CACHE_LINE_SIZE);
+	index->sortedIndex = (int *) malloc((index->n + 1) * sizeof(int));
+	if (index->tree == NULL || index->sortedIndex == NULL) {
+		eytzingerDestroy(index);
+		return -1;
+	}
+
+	index->sortedIndex[0] = -1;
+	eytzingerFill(index, (const char *) vData, 0, 1);
+	return 0;
+}
+
+/**
+ * Walk down from the root, going right whenever the element is
+ * less than the key.  The path taken spells out the answer: the
+ * last time we went left was at the first element not less than
+ * the key, so dropping the trailing right turns (1 bits) and that
+ * one left turn (a 0 bit) from the slot number gets us back to it.
+ */
+int
+eytzingerLowerBound(const EytzingerIndex *index, const void *key,
+		int (*comparator)(const void *, const void *))
+{
+	const char *tree = index->tree;
+	int tilesize = index->tilesize;
+	int levels = index->prefetchLevels;
+	int span = tilesize << levels;
+	unsigned int k = 1;
+	int offset;
+
+	while (k <= (unsigned int) index->n) {
+		/** the descendants "levels" below k start at slot k << levels */
+		for (offset = 0; offset < span; offset += CACHE_LINE_SIZE)
+			EYTZINGER_PREFETCH(&tree[((size_t) k << levels) * tilesize + offset]);
+
+		k = 2 * k + ((*comparator)(key, &tree[k * tilesize]) > 0);
+	}
+
+	k >>= __builtin_ffs(~k);
+	return (int) k;
+}
+
+void *
+eytzingerSearch(const EytzingerIndex *index, const void *key,
+		int (*comparator)(const void *, const void *))
+{
+	int k = eytzingerLowerBound(index, key, comparator);
+
+	if (k != 0 && (*comparator)(key, &index->tree[k * index->tilesize]) == 0)
+		return &index->tree[k * index->tilesize];
+	return NULL;
+}
+
+int
+eytzingerSortedIndex(const EytzingerIndex *index, const void *element)
+{
+	return index->sortedIndex[
+			((const char *) element - index->tree) / index->tilesize];
+}
+
+void
+eytzingerDestroy(EytzingerIndex *index)
+{
+	free(index->tree);
+	free(index->sortedIndex);
+	index->tree = NULL;
+	index->sortedIndex = NULL;
+	index->n = 0;
+}
@@ -0,0 +1,54 @@
+#ifndef	__BINARY_SEARCH_EYTZINGER_HEADER__
+#define	__BINARY_SEARCH_EYTZINGER_HEADER__
+
+/**
+ * An index over a sorted array that lays a copy of the elements out
+ * in "Eytzinger" (breadth first) order: the middle element first,
+ * then the middles of the two halves, then the four quarters, and
+ * so on, exactly as the elements would be visited level by level in
+ * a binary search.  Element k has its children at 2k and 2k+1.
+ *
+ * In a plain binary search each step lands somewhere quite far from
+ * the last, so every step of a search of a large array is a cache
+ * miss.  Here the first few levels all sit together at the start
+ * (and so stay in cache), and the 2^d descendants d levels below
+ * any element are next to each other in memory, so a search can
+ * prefetch where it will be several steps ahead before it gets
+ * there.
+ *
+ * Elements are copied into the index as they are, so it can be
+ * built over an array of structs or an array of pointers (or of
+ * keys taken out of either), and searched with the same comparators
+ * as binarysearch().
+ */
+
+typedef struct EytzingerIndex {
+	char *tree;			/* slots 1 to n; slot 0 is not used */
+	int *sortedIndex;	/* where each slot's element was in the sorted array */
+	int n;
+	int tilesize;
+	int prefetchLevels;	/* how far ahead the search prefetches */
+} EytzingerIndex;
+
+/* build an index over n sorted elements, returning -1 if out of memory */
+int
+eytzingerBuild(EytzingerIndex *index, const void *vData, int n, int tilesize);
+
+/* the slot of the first element not less than key, or 0 if there is none */
+int
+eytzingerLowerBound(const EytzingerIndex *index, const void *key,
+		int (*comparator)(const void *, const void *));
+
+/* the element equal to key, or NULL; as binarysearch() but on the index */
+void *
+eytzingerSearch(const EytzingerIndex *index, const void *key,
+		int (*comparator)(const void *, const void *));
+
+/* the position in the original sorted array of an element in the index */
+int
+eytzingerSortedIndex(const EytzingerIndex *index, const void *element);
+
+void
+eytzingerDestroy(EytzingerIndex *index);
+
+#endif	/* __BINARY_SEARCH_EYTZINGER_HEADER__ */
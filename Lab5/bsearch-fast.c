@@ -0,0 +1,94 @@
+/*
+ * Branchless binary search of a generic array,
+ * without any of the printing of bsearch-verbose.c
+ */
+#include <stdio.h>
+#include "bsearch-fast.h"
+
+/** ask for memory to be brought into cache ahead of when we need it */
+#if defined(__GNUC__)
+#define	BSEARCH_PREFETCH(address)	__builtin_prefetch(address)
+#else
+#define	BSEARCH_PREFETCH(address)	((void) (address))
+#endif
+
+/**
+ * Shared by both bounds: narrow the range down to the single
+ * element where the answer lies, moving up past an element only
+ * when the comparator returns a value >= threshold -- that is,
+ * when the element is less than the key (threshold 1, for the
+ * lower bound) or not greater than it (threshold 0, the upper).
+ *
+ * "base" is the first element still in the range and "len" how
+ * many are in it.  We look at the element "half" along: either the
+ * range becomes the second part, starting at that element, or the
+ * first part of the same length.  Whichever it is, the range is
+ * then len - half long, so the next look will be at one of the two
+ * places prefetched below.
+ */
+static int
+boundfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int threshold
+		)
+{
+	const char *base = (const char *) vData;
+	int len = n;
+	int half, c;
+
+	if (n <= 0)
+		return 0;
+
+	while (len > 1) {
+		half = len / 2;
+		len -= half;
+
+		BSEARCH_PREFETCH(&base[(len / 2) * tilesize]);
+		BSEARCH_PREFETCH(&base[(half + len / 2) * tilesize]);
+
+		c = (*comparator)(key, &base[half * tilesize]);
+		base += (c >= threshold) * half * tilesize;
+	}
+
+	/** the last element left may itself still be below the key */
+	c = (*comparator)(key, base);
+	return (int) ((base - (const char *) vData) / tilesize) + (c >= threshold);
+}
+
+int
+lowerboundfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		)
+{
+	return boundfast(key, vData, n, tilesize, comparator, 1);
+}
+
+int
+upperboundfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		)
+{
+	return boundfast(key, vData, n, tilesize, comparator, 0);
+}
+
+/**
+ * The lower bound is the only place the key could be, so
+ * one more comparison tells us whether it is there
+ */
+void *
+binarysearchfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		)
+{
+	char *cData = (char *) vData;
+	int index;
+
+	index = lowerboundfast(key, vData, n, tilesize, comparator);
+	if (index < n && (*comparator)(key, &cData[index * tilesize]) == 0)
+		return &cData[index * tilesize];
+	return NULL;
+}
@@ -0,0 +1,43 @@
+#ifndef	__BINARY_SEARCH_FAST_HEADER__
+#define	__BINARY_SEARCH_FAST_HEADER__
+
+/**
+ * Quiet versions of the binary search in bsearch-verbose.h, for
+ * use where the search is on the hot path.
+ *
+ * The arguments are the same as for binarysearch(): the comparator
+ * is handed the key first and an element of the array second, and
+ * returns <0, 0 or >0 as the key is less than, equal to or greater
+ * than that element.
+ *
+ * The loops are "branchless": every search of n elements does the
+ * same ceil(log2(n)) + 1 comparisons, and the result of each
+ * comparison only feeds an arithmetic update of where we are, which
+ * the compiler turns into a conditional move rather than a jump the
+ * processor would have to guess at.  As the next element we might
+ * look at is one of only two, both are prefetched before the
+ * comparator is called.
+ */
+
+/* as binarysearch(), but silent; finds the first of any equal elements */
+void *
+binarysearchfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		);
+
+/* the index of the first element not less than key (n if none) */
+int
+lowerboundfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		);
+
+/* the index of the first element greater than key (n if none) */
+int
+upperboundfast(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		);
+
+#endif	/* __BINARY_SEARCH_FAST_HEADER__ */
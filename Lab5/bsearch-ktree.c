@@ -0,0 +1,155 @@
+/*
+ * Search tree of sixteen key nodes, each searched
+ * with a handful of vector instructions
+ */
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+#include <limits.h> /* for INT_MAX */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "bsearch-ktree.h"
+
+#define	CACHE_LINE_SIZE		64
+
+/** node k has its children at KTREE_CHILD(k, 0) to KTREE_CHILD(k, 16) */
+#define	KTREE_CHILD(k, i)	((k) * (KTREE_NODE_KEYS + 1) + (i) + 1)
+
+
+/**
+ * Fill the nodes in order: everything in child i of a node comes
+ * before key i of the node, and everything in the last child after
+ * all of its keys.  Once the elements run out, the remaining slots
+ * are filled with INT_MAX; as these all come after every real key
+ * in order, a real key always wins over them in a search.
+ */
+static int
+karyTreeFill(KaryTree *tree, int k, int nextSorted,
+		int (*getKey)(const void *element))
+{
+	int i, slot;
+
+	if (k >= tree->nNodes)
+		return nextSorted;
+
+	for (i = 0; i < KTREE_NODE_KEYS; i++) {
+		nextSorted = karyTreeFill(tree, KTREE_CHILD(k, i), nextSorted, getKey);
+
+		slot = k * KTREE_NODE_KEYS + i;
+		if (nextSorted < tree->n) {
+			tree->keys[slot] = (*getKey)(&tree->data[nextSorted * tree->tilesize]);
+			tree->ranks[slot] = nextSorted++;
+		} else {
+			tree->keys[slot] = INT_MAX;
+			tree->ranks[slot] = tree->n;
+		}
+	}
+
+	return karyTreeFill(tree, KTREE_CHILD(k, KTREE_NODE_KEYS), nextSorted, getKey);
+}
+
+int
+karyTreeBuild(KaryTree *tree, const void *vData, int n, int tilesize,
+		int (*getKey)(const void *element))
+{
+	size_t nSlots;
+
+	tree->data = (const char *) vData;
+	tree->n = (n > 0) ? n : 0;
+	tree->tilesize = tilesize;
+	tree->nNodes = (tree->n + KTREE_NODE_KEYS - 1) / KTREE_NODE_KEYS;
+
+	/** always allocate at least one node so that freeing is simple */
+	nSlots = (size_t) (tree->nNodes > 0 ? tree->nNodes : 1) * KTREE_NODE_KEYS;
+	tree->keys = (int *) aligned_alloc(CACHE_LINE_SIZE, nSlots * sizeof(int));
+	tree->ranks = (int *) malloc(nSlots * sizeof(int));
+	if (tree->keys == NULL || tree->ranks == NULL) {
+		karyTreeDestroy(tree);
+		return -1;
+	}
+
+	karyTreeFill(tree, 0, 0, getKey);
+	return 0;
+}
+
+/**
+ * How many of the sixteen keys in a node are less than key --
+ * as they are sorted, this is also the position of the first one
+ * that is not
+ */
+static inline int
+karyNodeRank(const int *node, int key)
+{
+#if defined(__SSE2__)
+	__m128i keyVector = _mm_set1_epi32(key);
+	__m128i lt0, lt1, lt2, lt3;
+	unsigned int mask;
+
+	lt0 = _mm_cmplt_epi32(_mm_load_si128((const __m128i *) &node[0]), keyVector);
+	lt1 = _mm_cmplt_epi32(_mm_load_si128((const __m128i *) &node[4]), keyVector);
+	lt2 = _mm_cmplt_epi32(_mm_load_si128((const __m128i *) &node[8]), keyVector);
+	lt3 = _mm_cmplt_epi32(_mm_load_si128((const __m128i *) &node[12]), keyVector);
+
+	/** squeeze the sixteen 32 bit results into sixteen bytes, one bit each */
+	mask = _mm_movemask_epi8(_mm_packs_epi16(
+			_mm_packs_epi32(lt0, lt1), _mm_packs_epi32(lt2, lt3)));
+	return __builtin_popcount(mask);
+#else
+	int i, rank = 0;
+
+	for (i = 0; i < KTREE_NODE_KEYS; i++)
+		rank += (node[i] < key);
+	return rank;
+#endif
+}
+
+/**
+ * Walk down the tree, remembering the last key we passed that was
+ * not less than ours; the key we want is the smallest such key, and
+ * each one we find lower down is smaller than the ones above it.
+ * The slot of that key tells us where it is in the array.
+ */
+static int
+karyTreeLowerBoundSlot(const KaryTree *tree, int key)
+{
+	int k = 0, rank, slot = -1;
+
+	while (k < tree->nNodes) {
+		rank = karyNodeRank(&tree->keys[k * KTREE_NODE_KEYS], key);
+		if (rank < KTREE_NODE_KEYS)
+			slot = k * KTREE_NODE_KEYS + rank;
+		k = KTREE_CHILD(k, rank);
+	}
+	return slot;
+}
+
+int
+karyTreeLowerBound(const KaryTree *tree, int key)
+{
+	int slot = karyTreeLowerBoundSlot(tree, key);
+
+	return (slot < 0) ? tree->n : tree->ranks[slot];
+}
+
+void *
+karyTreeSearch(const KaryTree *tree, int key)
+{
+	int slot = karyTreeLowerBoundSlot(tree, key);
+
+	if (slot < 0 || tree->keys[slot] != key || tree->ranks[slot] == tree->n)
+		return NULL;
+	return (void *) &tree->data[tree->ranks[slot] * tree->tilesize];
+}
+
+void
+karyTreeDestroy(KaryTree *tree)
+{
+	free(tree->keys);
+	free(tree->ranks);
+	tree->keys = NULL;
+	tree->ranks = NULL;
+	tree->nNodes = 0;
+	tree->n = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef	__BINARY_SEARCH_KARY_TREE_HEADER__
+#define	__BINARY_SEARCH_KARY_TREE_HEADER__
+
+/**
+ * A static search tree over integer keys with 16 keys in each node.
+ *
+ * A binary search compares one key per step, but a 64 byte cache
+ * line holds sixteen ints and an SSE register holds four, so here
+ * each node is a single cache line of sixteen sorted keys with
+ * seventeen children.  A step of the search compares the key with
+ * all sixteen of them at once using four vector compares, and the
+ * number of keys that are less than ours (counted with a popcount)
+ * says which child to go to next.  A search therefore takes about
+ * log17(n) steps, each touching a single cache line.
+ *
+ * The nodes are stored level by level like the Eytzinger layout in
+ * bsearch-eytzinger.h, with the children of node k being nodes
+ * 17k+1 to 17k+17, so no child pointers are needed.
+ *
+ * The tree is built from a sorted array of any kind of element
+ * using a function that gets the integer key of an element, and
+ * searching it gives back the element from that array.
+ */
+
+/** the number of keys in each node: one cache line of ints */
+#define	KTREE_NODE_KEYS		16
+
+typedef struct KaryTree {
+	int *keys;			/* nNodes * KTREE_NODE_KEYS keys, cache line aligned */
+	int *ranks;			/* where each key came from in the sorted array */
+	int nNodes;
+
+	const char *data;	/* the array the tree was built over */
+	int n;
+	int tilesize;
+} KaryTree;
+
+/*
+ * build a tree over n elements sorted by the integer getKey()
+ * returns for each, returning -1 if out of memory
+ */
+int
+karyTreeBuild(KaryTree *tree, const void *vData, int n, int tilesize,
+		int (*getKey)(const void *element));
+
+/* the index in the array of the first element not less than key (n if none) */
+int
+karyTreeLowerBound(const KaryTree *tree, int key);
+
+/* the first element of the array whose key is equal to key, or NULL */
+void *
+karyTreeSearch(const KaryTree *tree, int key);
+
+void
+karyTreeDestroy(KaryTree *tree);
+
+#endif	/* __BINARY_SEARCH_KARY_TREE_HEADER__ */
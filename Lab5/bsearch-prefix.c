@@ -0,0 +1,121 @@
+/*
+ * Binary search on string keys using an index of
+ * normalized eight byte key prefixes, so that most
+ * steps compare two integers instead of calling
+ * strcmp() through two pointers
+ */
+#include <stdio.h>
+#include <stdlib.h> /* for malloc() */
+#include <string.h> /* for strcmp() */
+
+#include "bsearch-prefix.h"
+
+/** the number of bytes of each key kept in the index */
+#define	PREFIX_BYTES	((int) sizeof(unsigned long long))
+
+
+unsigned long long
+prefixIndexNormalize(const char *key)
+{
+	unsigned long long prefix = 0;
+	int i;
+
+	/** stop at the end of the string, leaving the rest zero */
+	for (i = 0; i < PREFIX_BYTES && key[i] != '\0'; i++)
+		prefix |= (unsigned long long) (unsigned char) key[i]
+				<< (8 * (PREFIX_BYTES - 1 - i));
+	return prefix;
+}
+
+int
+prefixIndexBuild(PrefixIndex *index, const void *vData, int n, int tilesize,
+		const char *(*getKey)(const void *element))
+{
+	const char *cData = (const char *) vData;
+	int i;
+
+	index->n = (n > 0) ? n : 0;
+	index->getKey = getKey;
+	index->entries = (PrefixIndexEntry *) malloc(
+			(index->n > 0 ? index->n : 1) * sizeof(PrefixIndexEntry));
+	if (index->entries == NULL)
+		return -1;
+
+	for (i = 0; i < index->n; i++) {
+		index->entries[i].element = &cData[i * tilesize];
+		index->entries[i].prefix = prefixIndexNormalize(
+				(*getKey)(index->entries[i].element));
+	}
+	return 0;
+}
+
+/**
+ * Is the key of this entry less than the key we are looking for?
+ *
+ * Only if the two prefixes are the same do we need to look at the
+ * strings -- and even then, if the prefix ends in a zero byte the
+ * key was shorter than the prefix, so both strings have ended and
+ * they are equal.
+ */
+static inline int
+entryIsLess(const PrefixIndex *index, const PrefixIndexEntry *entry,
+		unsigned long long keyPrefix, const char *key)
+{
+	if (entry->prefix != keyPrefix)
+		return entry->prefix < keyPrefix;
+	if ((keyPrefix & 0xff) == 0)
+		return 0;
+	return strcmp((*index->getKey)(entry->element) + PREFIX_BYTES,
+			key + PREFIX_BYTES) < 0;
+}
+
+/**
+ * A branchless lower bound, as in bsearch-fast.c, over the entries
+ */
+int
+prefixIndexLowerBound(const PrefixIndex *index, const char *key)
+{
+	const PrefixIndexEntry *base = index->entries;
+	unsigned long long keyPrefix = prefixIndexNormalize(key);
+	int len = index->n;
+	int half;
+
+	if (len <= 0)
+		return 0;
+
+	while (len > 1) {
+		half = len / 2;
+		len -= half;
+		base += entryIsLess(index, &base[half], keyPrefix, key) * half;
+	}
+
+	return (int) (base - index->entries)
+			+ entryIsLess(index, base, keyPrefix, key);
+}
+
+void *
+prefixIndexSearch(const PrefixIndex *index, const char *key)
+{
+	const PrefixIndexEntry *entry;
+	int i;
+
+	i = prefixIndexLowerBound(index, key);
+	if (i >= index->n)
+		return NULL;
+
+	entry = &index->entries[i];
+	if (entry->prefix != prefixIndexNormalize(key))
+		return NULL;
+	if ((entry->prefix & 0xff) != 0
+			&& strcmp((*index->getKey)(entry->element), key) != 0)
+		return NULL;
+	return (void *) entry->element;
+}
+
+void
+prefixIndexDestroy(PrefixIndex *index)
+{
+	free(index->entries);
+	index->entries = NULL;
+	index->n = 0;
+}
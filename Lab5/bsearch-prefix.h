@@ -0,0 +1,55 @@
+#ifndef	__BINARY_SEARCH_PREFIX_HEADER__
+#define	__BINARY_SEARCH_PREFIX_HEADER__
+
+/**
+ * An index for searching an array on a string key without chasing
+ * pointers at every step.
+ *
+ * Comparing a key with an element of an array of pointers to
+ * structs means following the pointer to the struct and then the
+ * pointer to its string -- two misses, one after the other -- before
+ * strcmp() can even start.  Here each element has an entry holding
+ * the first eight bytes of its key packed big-endian into an integer
+ * (padded with zero bytes if the key is shorter), alongside a
+ * pointer to the element itself.  Comparing two such integers gives
+ * the same answer as strcmp() would on those first eight bytes, so
+ * most steps of a search are a single integer comparison within the
+ * index, and the strings are only looked at when two keys share
+ * their first eight bytes.
+ */
+
+typedef struct PrefixIndexEntry {
+	unsigned long long prefix;
+	const void *element;	/* in the array the index was built over */
+} PrefixIndexEntry;
+
+typedef struct PrefixIndex {
+	PrefixIndexEntry *entries;
+	int n;
+	const char *(*getKey)(const void *element);
+} PrefixIndex;
+
+/* the first eight bytes of a string packed big-endian into an integer */
+unsigned long long
+prefixIndexNormalize(const char *key);
+
+/*
+ * build an index over n elements sorted by the string getKey()
+ * returns for each, returning -1 if out of memory
+ */
+int
+prefixIndexBuild(PrefixIndex *index, const void *vData, int n, int tilesize,
+		const char *(*getKey)(const void *element));
+
+/* the position of the first entry whose key is not less than key */
+int
+prefixIndexLowerBound(const PrefixIndex *index, const char *key);
+
+/* the element whose key is equal to key, or NULL */
+void *
+prefixIndexSearch(const PrefixIndex *index, const char *key);
+
+void
+prefixIndexDestroy(PrefixIndex *index);
+
+#endif	/* __BINARY_SEARCH_PREFIX_HEADER__ */
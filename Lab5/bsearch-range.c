@@ -0,0 +1,160 @@
+/*
+ * Lower and upper bound, equal range and prefix range
+ * queries over a generic sorted array
+ */
+#include <stdio.h>
+#include <string.h> /* for strncmp() */
+
+#include "bsearch-range.h"
+
+/**
+ * The bounds we can gallop towards: lowerboundfast() and
+ * upperboundfast() have the same arguments, so either can be
+ * used to finish the search once the answer has been bracketed
+ */
+typedef int (*BoundFunction)(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *)
+		);
+
+/**
+ * Step forward from hint until we pass the answer, doubling the
+ * step each time, then search only the last step.
+ *
+ * "isBefore" is true of the elements that come before the answer;
+ * if the element just before hint is not one of them, the answer is
+ * before hint after all, and we fall back on searching up to there.
+ */
+static int
+gallopfrom(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int hint, int threshold, BoundFunction bound
+		)
+{
+	const char *cData = (const char *) vData;
+	int low, high, step;
+
+	if (hint > n)
+		hint = n;
+	if (hint <= 0)
+		return (*bound)(key, vData, n, tilesize, comparator);
+
+	/** an element comes before the answer if comparing to it gives >= threshold */
+	if ((*comparator)(key, &cData[(hint - 1) * tilesize]) < threshold)
+		return (*bound)(key, vData, hint - 1, tilesize, comparator);
+
+	/** everything before low is known to be before the answer */
+	low = hint;
+	high = hint;
+	step = 1;
+	while (high < n
+			&& (*comparator)(key, &cData[high * tilesize]) >= threshold) {
+		low = high + 1;
+		high = (n - hint > step) ? hint + step : n;
+		step *= 2;
+	}
+
+	/** the answer is now somewhere in [low, high] */
+	return low + (*bound)(key, &cData[low * tilesize], high - low,
+			tilesize, comparator);
+}
+
+int
+lowerboundfrom(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int hint
+		)
+{
+	return gallopfrom(key, vData, n, tilesize, comparator,
+			hint, 1, lowerboundfast);
+}
+
+int
+upperboundfrom(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int hint
+		)
+{
+	return gallopfrom(key, vData, n, tilesize, comparator,
+			hint, 0, upperboundfast);
+}
+
+/**
+ * Runs of equal keys are usually short, so rather than a second
+ * full search, gallop to the end of the run from its start
+ */
+int
+equalrange(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int *first, int *last
+		)
+{
+	*first = lowerboundfast(key, vData, n, tilesize, comparator);
+	*last = upperboundfrom(key, vData, n, tilesize, comparator, *first);
+	return *last - *first;
+}
+
+
+/**
+ * The elements that start with the prefix are those that compare
+ * equal to it on its first prefixLength characters.  We can't hand
+ * a length to a comparator, so these bounds are done directly, in
+ * the same branchless style as bsearch-fast.c.
+ */
+static int
+prefixbound(
+		const char *prefix, size_t prefixLength,
+		const char *cData, int n, int tilesize,
+		const char *(*getKey)(const void *element),
+		int threshold
+		)
+{
+	const char *base = cData;
+	int len = n;
+	int half, c;
+
+	if (n <= 0)
+		return 0;
+
+	while (len > 1) {
+		half = len / 2;
+		len -= half;
+		c = strncmp(prefix, (*getKey)(&base[half * tilesize]), prefixLength);
+		base += (c >= threshold) * half * tilesize;
+	}
+
+	c = strncmp(prefix, (*getKey)(base), prefixLength);
+	return (int) ((base - cData) / tilesize) + (c >= threshold);
+}
+
+int
+prefixrange(
+		const char *prefix, const void *vData, int n, int tilesize,
+		const char *(*getKey)(const void *element),
+		int *first, int *last
+		)
+{
+	const char *cData = (const char *) vData;
+	size_t prefixLength = strlen(prefix);
+	int low, high, step;
+
+	*first = prefixbound(prefix, prefixLength, cData, n, tilesize, getKey, 1);
+
+	/** gallop from the start of the range to find its end, as above */
+	low = high = *first;
+	step = 1;
+	while (high < n && strncmp(prefix,
+				(*getKey)(&cData[high * tilesize]), prefixLength) >= 0) {
+		low = high + 1;
+		high = (n - *first > step) ? *first + step : n;
+		step *= 2;
+	}
+
+	*last = low + prefixbound(prefix, prefixLength, &cData[low * tilesize],
+			high - low, tilesize, getKey, 0);
+	return *last - *first;
+}
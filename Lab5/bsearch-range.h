@@ -0,0 +1,64 @@
+#ifndef	__BINARY_SEARCH_RANGE_HEADER__
+#define	__BINARY_SEARCH_RANGE_HEADER__
+
+/**
+ * Range queries over a sorted array, using the same generic model
+ * of an array (vData, n, tilesize) and comparator as binarysearch().
+ *
+ * binarysearch() finds one element equal to the key, if there is
+ * one.  With duplicate keys, or to find every element whose key
+ * starts with some string, we want the whole range of positions
+ * instead.  The lower and upper bounds of bsearch-fast.h give the
+ * two ends of such a range; the functions here build on those.
+ *
+ * Ranges are given as [first, last): first is the position of the
+ * first element in the range and last is one past the last one, so
+ * last - first is the number of elements, and an empty range has
+ * first == last (where the key would go).
+ *
+ * When the answer is known to be at or after some position -- the
+ * end of a range is after its start, and when keys are looked up in
+ * increasing order each answer is after the last one -- the "from"
+ * versions start there and gallop forward in steps of 1, 2, 4, ...
+ * before searching, which costs O(log d) comparisons for an answer
+ * d places on, rather than O(log n).
+ */
+
+#include "bsearch-fast.h"
+
+/* as lowerboundfast(), for an answer expected at or after position hint */
+int
+lowerboundfrom(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int hint
+		);
+
+/* as upperboundfast(), for an answer expected at or after position hint */
+int
+upperboundfrom(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int hint
+		);
+
+/* the range of elements equal to key; returns how many there are */
+int
+equalrange(
+		const void *key, const void *vData, int n, int tilesize,
+		int (*comparator)(const void *, const void *),
+		int *first, int *last
+		);
+
+/*
+ * the range of elements whose string key (given by getKey()) starts
+ * with prefix, for an array sorted on that key; returns how many
+ */
+int
+prefixrange(
+		const char *prefix, const void *vData, int n, int tilesize,
+		const char *(*getKey)(const void *element),
+		int *first, int *last
+		);
+
+#endif	/* __BINARY_SEARCH_RANGE_HEADER__ */
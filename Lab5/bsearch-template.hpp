@@ -0,0 +1,89 @@
+#ifndef	__BINARY_SEARCH_TEMPLATE_HEADER__
+#define	__BINARY_SEARCH_TEMPLATE_HEADER__
+
+/**
+ * C++ template versions of the searches in bsearch-fast.h.
+ *
+ * binarysearch() and binarysearchfast() only see the array as bytes
+ * and the comparator as a function pointer, so every step multiplies
+ * by a tile size known only at run time and makes an indirect call
+ * that can never be inlined.  These templates are instantiated for
+ * each element type and comparator, so the stride is a constant and
+ * a comparator given as a lambda or function object is compiled
+ * straight into the loop.
+ *
+ * As for the C versions, the comparator is called as
+ * compare(key, element) and returns <0, 0 or >0.
+ */
+
+namespace search {
+
+/** the index of the first element not less than key (n if none) */
+template <typename T, typename Key, typename Compare>
+inline int
+lowerBound(const Key &key, const T *data, int n, Compare compare)
+{
+	const T *base = data;
+	int len = n;
+	int half;
+
+	if (n <= 0)
+		return 0;
+
+	while (len > 1) {
+		half = len / 2;
+		len -= half;
+
+#if defined(__GNUC__)
+		__builtin_prefetch(&base[len / 2]);
+		__builtin_prefetch(&base[half + len / 2]);
+#endif
+
+		base += (compare(key, base[half]) > 0) * half;
+	}
+
+	return (int) (base - data) + (compare(key, *base) > 0);
+}
+
+/** the index of the first element greater than key (n if none) */
+template <typename T, typename Key, typename Compare>
+inline int
+upperBound(const Key &key, const T *data, int n, Compare compare)
+{
+	const T *base = data;
+	int len = n;
+	int half;
+
+	if (n <= 0)
+		return 0;
+
+	while (len > 1) {
+		half = len / 2;
+		len -= half;
+
+#if defined(__GNUC__)
+		__builtin_prefetch(&base[len / 2]);
+		__builtin_prefetch(&base[half + len / 2]);
+#endif
+
+		base += (compare(key, base[half]) >= 0) * half;
+	}
+
+	return (int) (base - data) + (compare(key, *base) >= 0);
+}
+
+/** the first element equal to key, or nullptr */
+template <typename T, typename Key, typename Compare>
+inline T *
+binarySearch(const Key &key, T *data, int n, Compare compare)
+{
+	int index = lowerBound(key, (const T *) data, n, compare);
+
+	if (index < n && compare(key, data[index]) == 0)
+		return &data[index];
+	return nullptr;
+}
+
+} /* namespace search */
+
+#endif	/* __BINARY_SEARCH_TEMPLATE_HEADER__ */
@@ -0,0 +1,158 @@
+/*
+ * Time the generic C binary search against the C++
+ * template one on large arrays of fruit-like records,
+ * searched by the common name in an array of structs,
+ * and by the latin name and latin index in an array
+ * of pointers to the structs
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+
+#include "bsearch-template.hpp"
+
+extern "C" {
+#include "bsearch-fast.h"
+#include "FruitData.h"
+}
+
+#define	DEFAULT_N_RECORDS	(1 << 20)
+#define	N_LOOKUPS			(1 << 21)
+
+static int
+structComparator_CommonName(const void *vKey, const void *vData)
+{
+	return strcmp((const char *) vKey, ((const FruitData *) vData)->common);
+}
+
+static int
+pointerComparator_LatinName(const void *vKey, const void *vData)
+{
+	return strcmp((const char *) vKey, (*(FruitData * const *) vData)->latin);
+}
+
+static int
+pointerComparator_LatinIndex(const void *vKey, const void *vData)
+{
+	int key = *(const int *) vKey;
+	int latinIndex = (*(FruitData * const *) vData)->latinIndex;
+
+	return (key > latinIndex) - (key < latinIndex);
+}
+
+/** a random name, so that names share few leading characters */
+static char *
+randomName(char *buffer)
+{
+	int i, len = 6 + rand() % 8;
+
+	for (i = 0; i < len; i++)
+		buffer[i] = 'a' + rand() % 26;
+	buffer[len] = '\0';
+	return strdup(buffer);
+}
+
+static double
+secondsSince(clock_t start)
+{
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int
+main(int argc, char **argv)
+{
+	int nRecords = (argc > 1) ? atoi(argv[1]) : DEFAULT_N_RECORDS;
+	std::vector<FruitData> dataArray(nRecords);
+	std::vector<FruitData *> dataPointers(nRecords);
+	std::vector<const char *> commonKeys(N_LOOKUPS), latinKeys(N_LOOKUPS);
+	std::vector<int> indexKeys(N_LOOKUPS);
+	char buffer[32];
+	long nFound;
+	clock_t start;
+	int i;
+
+	if (nRecords < 1) {
+		fprintf(stderr, "Error: bad record count '%s'\n", argv[1]);
+		return -1;
+	}
+
+	srand(2520);
+	for (i = 0; i < nRecords; i++) {
+		dataArray[i].common = randomName(buffer);
+		dataArray[i].latin = randomName(buffer);
+	}
+
+	std::sort(dataArray.begin(), dataArray.end(),
+			[](const FruitData &a, const FruitData &b) {
+				return strcmp(a.common, b.common) < 0;
+			});
+	for (i = 0; i < nRecords; i++)
+		dataPointers[i] = &dataArray[i];
+	std::sort(dataPointers.begin(), dataPointers.end(),
+			[](const FruitData *a, const FruitData *b) {
+				return strcmp(a->latin, b->latin) < 0;
+			});
+	for (i = 0; i < nRecords; i++)
+		dataPointers[i]->latinIndex = i;
+
+	/** half of the lookups are for names that are there */
+	for (i = 0; i < N_LOOKUPS; i++) {
+		commonKeys[i] = (i & 1) ? dataArray[rand() % nRecords].common : "zzzz";
+		latinKeys[i] = (i & 1) ? dataArray[rand() % nRecords].latin : "zzzz";
+		indexKeys[i] = (i & 1) ? rand() % nRecords : -1;
+	}
+
+	printf("%d lookups in %d records\n", N_LOOKUPS, nRecords);
+
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (binarysearchfast(commonKeys[i], dataArray.data(), nRecords,
+					sizeof(FruitData), structComparator_CommonName) != NULL);
+	printf("  common, generic C  : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (search::binarySearch(commonKeys[i], dataArray.data(), nRecords,
+					[](const char *key, const FruitData &fruitData) {
+						return strcmp(key, fruitData.common);
+					}) != nullptr);
+	printf("  common, template   : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (binarysearchfast(latinKeys[i], dataPointers.data(), nRecords,
+					sizeof(FruitData *), pointerComparator_LatinName) != NULL);
+	printf("  latin, generic C   : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (search::binarySearch(latinKeys[i], dataPointers.data(), nRecords,
+					[](const char *key, const FruitData *fruitData) {
+						return strcmp(key, fruitData->latin);
+					}) != nullptr);
+	printf("  latin, template    : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	/** with an integer key the comparison itself is what gets inlined */
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (binarysearchfast(&indexKeys[i], dataPointers.data(), nRecords,
+					sizeof(FruitData *), pointerComparator_LatinIndex) != NULL);
+	printf("  index, generic C   : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	start = clock();
+	for (nFound = 0, i = 0; i < N_LOOKUPS; i++)
+		nFound += (search::binarySearch(indexKeys[i], dataPointers.data(), nRecords,
+					[](int key, const FruitData *fruitData) {
+						return (key > fruitData->latinIndex) - (key < fruitData->latinIndex);
+					}) != nullptr);
+	printf("  index, template    : %6.3fs (%ld found)\n", secondsSince(start), nFound);
+
+	for (i = 0; i < nRecords; i++) {
+		free(dataArray[i].common);
+		free(dataArray[i].latin);
+	}
+	return 0;
+}
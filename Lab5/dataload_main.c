@@ -21,6 +21,15 @@
 #define	ACTION_LATIN	2
 #define	ACTION_BOTH		(ACTION_COMMON|ACTION_LATIN)
 
+#define	SEARCH_VERBOSE		0
+#define	SEARCH_FAST			1
+#define	SEARCH_EYTZINGER	2
+#define	SEARCH_BATCH		3
+#define	SEARCH_PREFIX		4
+#define	SEARCH_TEMPLATE		5
+#define	SEARCH_KARY_TREE	6
+#define	SEARCH_PREFIX_RANGE	7
+
 
 void
 usage(char *programname, const FruitData *dataArray, int datalength)
@@ -35,9 +44,19 @@ usage(char *programname, const FruitData *dataArray, int datalength)
 	fprintf(stderr, "-C  : search on the common name key only\n");
 	fprintf(stderr, "-L  : search on the latin name key only\n");
 	fprintf(stderr, "-B  : search on the both keys (default)\n");
+	fprintf(stderr, "-F  : use the fast search, without printing each step\n");
+	fprintf(stderr, "-E  : search a breadth first (Eytzinger) ordered index\n");
+	fprintf(stderr, "-M  : search for every key given, all in one batch\n");
+	fprintf(stderr, "-P  : search an index of key prefixes\n");
+	fprintf(stderr, "-T  : use the C++ template search\n");
+	fprintf(stderr, "-K n: search on the latin index for the number n (which\n");
+	fprintf(stderr, "      may be negative) using a tree of 16 key nodes; give\n");
+	fprintf(stderr, "      -K more than once to search for several numbers\n");
+	fprintf(stderr, "-R  : find every name that starts with the key\n");
 	fprintf(stderr, "\n");
 	fprintf(stderr, "If supplied, the key replaces the default key '%s'/'%s'\n",
 			COMMON_KEY, LATIN_KEY);
+	fprintf(stderr, "(with -M, -E or -P, any number of keys may be given)\n");
 	fprintf(stderr, "\n");
 	fprintf(stderr, "Below is the data set in common key order.\n");
 	fprintf(stderr, "\n");
@@ -68,8 +87,18 @@ main(int argc, char **argv)
 
 	char *latinKey = LATIN_KEY;
 	char *commonKey = COMMON_KEY;
+	char **keys = NULL;
+	char **commonKeys, **latinKeys;
+	int nKeys = 0, nSearchKeys;
+
+	EytzingerIndex commonIndex, latinIndex;
+	PrefixIndex commonPrefixIndex, latinPrefixIndex;
+	KaryTree indexTree;
+	int *indexKeys = NULL;
+	int nIndexKeys = 0;
 
 	int action = ACTION_BOTH;
+	int searchMethod = SEARCH_VERBOSE;
 	int i;
 
 	// check that our arrays match in size
@@ -80,18 +109,40 @@ main(int argc, char **argv)
 		dataPointers[ dataArray[i].latinIndex ] = &dataArray[i];
 	}
 
+	// every key given is kept for searches that take many keys
+	keys = (char **) malloc(argc * sizeof(char *));
+	indexKeys = (int *) malloc(argc * sizeof(int));
+	if (keys == NULL || indexKeys == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		free(indexKeys);
+		free(keys);
+		return 1;
+	}
+
 	// process command line
 	for (i = 1; i < argc; i++) {
 		if (argv[i][0] == '-') {
 			if (argv[i][1] == 'L')	action = ACTION_LATIN;
 			else if (argv[i][1] == 'C')	action = ACTION_COMMON;
 			else if (argv[i][1] == 'B')	action = ACTION_BOTH;
+			else if (argv[i][1] == 'F')	searchMethod = SEARCH_FAST;
+			else if (argv[i][1] == 'E')	searchMethod = SEARCH_EYTZINGER;
+			else if (argv[i][1] == 'M')	searchMethod = SEARCH_BATCH;
+			else if (argv[i][1] == 'P')	searchMethod = SEARCH_PREFIX;
+			else if (argv[i][1] == 'T')	searchMethod = SEARCH_TEMPLATE;
+			else if (argv[i][1] == 'K' && i + 1 < argc) {
+				// the number is the option's argument, so it may start with '-'
+				searchMethod = SEARCH_KARY_TREE;
+				indexKeys[nIndexKeys++] = atoi(argv[++i]);
+			}
+			else if (argv[i][1] == 'R')	searchMethod = SEARCH_PREFIX_RANGE;
 			else {
 				usage(argv[0], dataArray, NUMBER_OF_FRUITS);
 			}
 				
 		} else {
 			latinKey = commonKey = argv[i];
+			keys[nKeys++] = argv[i];
 		}
 	}
 
@@ -103,7 +154,138 @@ main(int argc, char **argv)
 	printf("\n\n");
 
 
+	// with no keys given, each search uses its own default key
+	commonKeys = (nKeys > 0) ? keys : &commonKey;
+	latinKeys = (nKeys > 0) ? keys : &latinKey;
+	nSearchKeys = (nKeys > 0) ? nKeys : 1;
+
 	// do the searches
+	if (searchMethod == SEARCH_KARY_TREE) {
+		// the pointers are in latin index order too
+		if (buildLatinIndexKaryTree(&indexTree,
+					dataPointers, NUMBER_OF_FRUITS) < 0) {
+			fprintf(stderr, "Out of memory\n");
+			free(indexKeys);
+			free(keys);
+			return 1;
+		}
+		for (i = 0; i < nIndexKeys; i++)
+			searchInLatinIndexKaryTree(&indexTree, dataPointers, indexKeys[i]);
+		karyTreeDestroy(&indexTree);
+
+		free(indexKeys);
+		free(keys);
+		return 0;
+	}
+	free(indexKeys);
+
+	if (searchMethod == SEARCH_BATCH) {
+		if (action & ACTION_COMMON)
+			searchInCommonNameBatch(dataArray, NUMBER_OF_FRUITS,
+					commonKeys, nSearchKeys);
+
+		if (action & ACTION_LATIN)
+			searchInLatinNameBatch(dataPointers, NUMBER_OF_FRUITS,
+					latinKeys, nSearchKeys);
+
+		free(keys);
+		return 0;
+	}
+
+	// each index is built once, then every key is looked up in it
+	if (searchMethod == SEARCH_EYTZINGER) {
+		if (action & ACTION_COMMON) {
+			if (eytzingerBuild(&commonIndex, dataArray, NUMBER_OF_FRUITS,
+						sizeof(FruitData)) < 0) {
+				fprintf(stderr, "Out of memory\n");
+				free(keys);
+				return 1;
+			}
+			for (i = 0; i < nSearchKeys; i++)
+				searchInCommonNameEytzinger(&commonIndex, commonKeys[i]);
+			eytzingerDestroy(&commonIndex);
+		}
+
+		if (action & ACTION_LATIN) {
+			if (eytzingerBuild(&latinIndex, dataPointers, NUMBER_OF_FRUITS,
+						sizeof(FruitData *)) < 0) {
+				fprintf(stderr, "Out of memory\n");
+				free(keys);
+				return 1;
+			}
+			for (i = 0; i < nSearchKeys; i++)
+				searchInLatinNameEytzinger(&latinIndex, latinKeys[i]);
+			eytzingerDestroy(&latinIndex);
+		}
+
+		free(keys);
+		return 0;
+	}
+
+	if (searchMethod == SEARCH_PREFIX) {
+		if (action & ACTION_COMMON) {
+			if (buildCommonNamePrefixIndex(&commonPrefixIndex,
+						dataArray, NUMBER_OF_FRUITS) < 0) {
+				fprintf(stderr, "Out of memory\n");
+				free(keys);
+				return 1;
+			}
+			for (i = 0; i < nSearchKeys; i++)
+				searchInCommonNamePrefix(&commonPrefixIndex, dataArray,
+						commonKeys[i]);
+			prefixIndexDestroy(&commonPrefixIndex);
+		}
+
+		if (action & ACTION_LATIN) {
+			if (buildLatinNamePrefixIndex(&latinPrefixIndex,
+						dataPointers, NUMBER_OF_FRUITS) < 0) {
+				fprintf(stderr, "Out of memory\n");
+				free(keys);
+				return 1;
+			}
+			for (i = 0; i < nSearchKeys; i++)
+				searchInLatinNamePrefix(&latinPrefixIndex, dataPointers,
+						latinKeys[i]);
+			prefixIndexDestroy(&latinPrefixIndex);
+		}
+
+		free(keys);
+		return 0;
+	}
+
+	free(keys);
+
+	if (searchMethod == SEARCH_FAST) {
+		if (action & ACTION_COMMON)
+			searchInCommonNameFast(dataArray, NUMBER_OF_FRUITS, commonKey);
+
+		if (action & ACTION_LATIN)
+			searchInLatinNameFast(dataPointers, NUMBER_OF_FRUITS, latinKey);
+
+		return 0;
+	}
+
+	if (searchMethod == SEARCH_PREFIX_RANGE) {
+		if (action & ACTION_COMMON)
+			searchInCommonNameRange(dataArray, NUMBER_OF_FRUITS, commonKey);
+
+		if (action & ACTION_LATIN)
+			searchInLatinNameRange(dataPointers, NUMBER_OF_FRUITS, latinKey);
+
+		return 0;
+	}
+
+
+	if (searchMethod == SEARCH_TEMPLATE) {
+		if (action & ACTION_COMMON)
+			searchInCommonNameTemplate(dataArray, NUMBER_OF_FRUITS, commonKey);
+
+		if (action & ACTION_LATIN)
+			searchInLatinNameTemplate(dataPointers, NUMBER_OF_FRUITS, latinKey);
+
+		return 0;
+	}
+
 	if (action & ACTION_COMMON)
 		searchInCommonName(dataArray, NUMBER_OF_FRUITS, commonKey);
 
@@ -0,0 +1,314 @@
+/*
+ * The same two searches as lab5_arraysearch.c and
+ * lab5_pointersearch.c, using the quiet branchless
+ * search in bsearch-fast.c, the breadth first
+ * index in bsearch-eytzinger.c, the batch search
+ * in bsearch-batch.c or the prefix index in
+ * bsearch-prefix.c, and comparators that only
+ * compare.  The pointers are also in latin index
+ * order, so they can be searched on that with the
+ * tree in bsearch-ktree.c.  Every name starting with
+ * a key can be found with bsearch-range.c
+ */
+#include <stdio.h>
+#include <stdlib.h> // for malloc()
+#include <string.h> // for strcmp()
+
+#include "bsearch-fast.h"
+#include "bsearch-eytzinger.h"
+#include "bsearch-batch.h"
+#include "bsearch-prefix.h"
+#include "bsearch-ktree.h"
+#include "bsearch-range.h"
+#include "FruitData.h"
+
+
+/**
+ * Comparator on the common name in an array of structs
+ */
+static int
+structComparator_CommonNameQuiet(const void *vKey, const void *vData)
+{
+	return strcmp((const char *) vKey, ((const FruitData *) vData)->common);
+}
+
+/**
+ * Comparator on the latin name in an array of pointers to structs
+ */
+static int
+pointerComparator_LatinNameQuiet(const void *vKey, const void *vData)
+{
+	return strcmp((const char *) vKey, (*(FruitData * const *) vData)->latin);
+}
+
+/**
+ * Key extractors for the prefix index
+ */
+static const char *
+structKey_CommonName(const void *vData)
+{
+	return ((const FruitData *) vData)->common;
+}
+
+static const char *
+pointerKey_LatinName(const void *vData)
+{
+	return (*(FruitData * const *) vData)->latin;
+}
+
+static int
+pointerKey_LatinIndex(const void *vData)
+{
+	return (*(FruitData * const *) vData)->latinIndex;
+}
+
+void
+searchInCommonNameFast(const FruitData *fruitDataArray, int nFruits, char *key)
+{
+	FruitData *arrayResult = NULL;
+
+	arrayResult = binarysearchfast(
+			key, fruitDataArray, nFruits, sizeof(FruitData),
+			structComparator_CommonNameQuiet);
+	if (arrayResult != NULL) {
+		printf("Common name search using '%s' returned:\n\t", key);
+		printFuitWithID(arrayResult, arrayResult - fruitDataArray);
+	} else {
+		printf("Common name search using '%s' FAILED\n", key);
+	}
+}
+
+void
+searchInLatinNameFast(FruitData * const *fruitDataPointers, int nFruits, char *key)
+{
+	FruitData **pointerResult = NULL;
+
+	pointerResult = binarysearchfast(
+			key, fruitDataPointers, nFruits, sizeof(FruitData *),
+			pointerComparator_LatinNameQuiet);
+	if (pointerResult != NULL) {
+		printf("Latin name search using '%s' returned:\n\t", key);
+		printFuitWithID(*pointerResult, pointerResult - fruitDataPointers);
+	} else {
+		printf("Latin name search using '%s' FAILED\n", key);
+	}
+}
+
+/**
+ * The index holds copies of the structs, so the result is one of
+ * those copies; the index tells us where it was in the array.  The
+ * index is built once by the caller and can be searched any number
+ * of times.
+ */
+void
+searchInCommonNameEytzinger(const EytzingerIndex *index, char *key)
+{
+	FruitData *indexResult = NULL;
+
+	indexResult = eytzingerSearch(index, key, structComparator_CommonNameQuiet);
+	if (indexResult != NULL) {
+		printf("Common name search using '%s' returned:\n\t", key);
+		printFuitWithID(indexResult, eytzingerSortedIndex(index, indexResult));
+	} else {
+		printf("Common name search using '%s' FAILED\n", key);
+	}
+}
+
+void
+searchInLatinNameEytzinger(const EytzingerIndex *index, char *key)
+{
+	FruitData **indexResult = NULL;
+
+	indexResult = eytzingerSearch(index, key, pointerComparator_LatinNameQuiet);
+	if (indexResult != NULL) {
+		printf("Latin name search using '%s' returned:\n\t", key);
+		printFuitWithID(*indexResult, eytzingerSortedIndex(index, indexResult));
+	} else {
+		printf("Latin name search using '%s' FAILED\n", key);
+	}
+}
+
+/**
+ * Look all of the keys up in one batch; the results come back
+ * in the same order as the keys
+ */
+void
+searchInCommonNameBatch(const FruitData *fruitDataArray, int nFruits,
+		char **keys, int nKeys)
+{
+	FruitData **arrayResults = NULL;
+	int i;
+
+	arrayResults = (FruitData **) malloc(nKeys * sizeof(FruitData *));
+	if (arrayResults == NULL) {
+		printf("Common name batch search FAILED : out of memory\n");
+		return;
+	}
+
+	binarysearchbatch((const void * const *) keys, nKeys,
+			fruitDataArray, nFruits, sizeof(FruitData),
+			structComparator_CommonNameQuiet, (void **) arrayResults);
+
+	for (i = 0; i < nKeys; i++) {
+		if (arrayResults[i] != NULL) {
+			printf("Common name search using '%s' returned:\n\t", keys[i]);
+			printFuitWithID(arrayResults[i], arrayResults[i] - fruitDataArray);
+		} else {
+			printf("Common name search using '%s' FAILED\n", keys[i]);
+		}
+	}
+
+	free(arrayResults);
+}
+
+void
+searchInLatinNameBatch(FruitData * const *fruitDataPointers, int nFruits,
+		char **keys, int nKeys)
+{
+	FruitData ***pointerResults = NULL;
+	int i;
+
+	pointerResults = (FruitData ***) malloc(nKeys * sizeof(FruitData **));
+	if (pointerResults == NULL) {
+		printf("Latin name batch search FAILED : out of memory\n");
+		return;
+	}
+
+	binarysearchbatch((const void * const *) keys, nKeys,
+			fruitDataPointers, nFruits, sizeof(FruitData *),
+			pointerComparator_LatinNameQuiet, (void **) pointerResults);
+
+	for (i = 0; i < nKeys; i++) {
+		if (pointerResults[i] != NULL) {
+			printf("Latin name search using '%s' returned:\n\t", keys[i]);
+			printFuitWithID(*pointerResults[i],
+					pointerResults[i] - fruitDataPointers);
+		} else {
+			printf("Latin name search using '%s' FAILED\n", keys[i]);
+		}
+	}
+
+	free(pointerResults);
+}
+
+/**
+ * The prefix indexes need the key getters above, so they are built
+ * here, once, and then searched by the drivers below
+ */
+int
+buildCommonNamePrefixIndex(PrefixIndex *index,
+		const FruitData *fruitDataArray, int nFruits)
+{
+	return prefixIndexBuild(index, fruitDataArray, nFruits, sizeof(FruitData),
+			structKey_CommonName);
+}
+
+int
+buildLatinNamePrefixIndex(PrefixIndex *index,
+		FruitData * const *fruitDataPointers, int nFruits)
+{
+	return prefixIndexBuild(index, fruitDataPointers, nFruits, sizeof(FruitData *),
+			pointerKey_LatinName);
+}
+
+/**
+ * The index points back into the array it was built over, so
+ * its results are elements of that array
+ */
+void
+searchInCommonNamePrefix(const PrefixIndex *index,
+		const FruitData *fruitDataArray, char *key)
+{
+	FruitData *arrayResult = NULL;
+
+	arrayResult = prefixIndexSearch(index, key);
+	if (arrayResult != NULL) {
+		printf("Common name search using '%s' returned:\n\t", key);
+		printFuitWithID(arrayResult, arrayResult - fruitDataArray);
+	} else {
+		printf("Common name search using '%s' FAILED\n", key);
+	}
+}
+
+void
+searchInLatinNamePrefix(const PrefixIndex *index,
+		FruitData * const *fruitDataPointers, char *key)
+{
+	FruitData **pointerResult = NULL;
+
+	pointerResult = prefixIndexSearch(index, key);
+	if (pointerResult != NULL) {
+		printf("Latin name search using '%s' returned:\n\t", key);
+		printFuitWithID(*pointerResult, pointerResult - fruitDataPointers);
+	} else {
+		printf("Latin name search using '%s' FAILED\n", key);
+	}
+}
+
+/**
+ * The tree is built once over the pointers, which are in latin
+ * index order, and then searched by the driver below
+ */
+int
+buildLatinIndexKaryTree(KaryTree *tree,
+		FruitData * const *fruitDataPointers, int nFruits)
+{
+	return karyTreeBuild(tree, fruitDataPointers, nFruits, sizeof(FruitData *),
+			pointerKey_LatinIndex);
+}
+
+void
+searchInLatinIndexKaryTree(const KaryTree *tree,
+		FruitData * const *fruitDataPointers, int key)
+{
+	FruitData **pointerResult = NULL;
+
+	pointerResult = karyTreeSearch(tree, key);
+	if (pointerResult != NULL) {
+		printf("Latin index search using %d returned:\n\t", key);
+		printFuitWithID(*pointerResult, pointerResult - fruitDataPointers);
+	} else {
+		printf("Latin index search using %d FAILED\n", key);
+	}
+}
+
+/**
+ * Print every element in the range of positions [first, last)
+ */
+void
+searchInCommonNameRange(const FruitData *fruitDataArray, int nFruits, char *key)
+{
+	int first, last, i;
+
+	if (prefixrange(key, fruitDataArray, nFruits, sizeof(FruitData),
+				structKey_CommonName, &first, &last) == 0) {
+		printf("Common name prefix search using '%s' FAILED\n", key);
+		return;
+	}
+
+	printf("Common name prefix search using '%s' returned %d:\n",
+			key, last - first);
+	for (i = first; i < last; i++) {
+		printf("\t");
+		printFuitWithID(&fruitDataArray[i], i);
+	}
+}
+
+void
+searchInLatinNameRange(FruitData * const *fruitDataPointers, int nFruits, char *key)
+{
+	int first, last, i;
+
+	if (prefixrange(key, fruitDataPointers, nFruits, sizeof(FruitData *),
+				pointerKey_LatinName, &first, &last) == 0) {
+		printf("Latin name prefix search using '%s' FAILED\n", key);
+		return;
+	}
+
+	printf("Latin name prefix search using '%s' returned %d:\n",
+			key, last - first);
+	for (i = first; i < last; i++) {
+		printf("\t");
+		printFuitWithID(fruitDataPointers[i], i);
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * The same two searches as lab5_arraysearch.c and
+ * lab5_pointersearch.c, using the C++ template search
+ * in bsearch-template.hpp so that the comparisons are
+ * compiled into the search loop itself
+ */
+#include <cstdio>
+#include <cstring> // for strcmp()
+
+#include "bsearch-template.hpp"
+
+extern "C" {
+#include "FruitData.h"
+}
+
+/**
+ * Comparator on the common name in an array of structs
+ */
+struct StructComparator_CommonName {
+	int operator()(const char *key, const FruitData &fruitData) const
+	{
+		return strcmp(key, fruitData.common);
+	}
+};
+
+/**
+ * Comparator on the latin name in an array of pointers to structs
+ */
+struct PointerComparator_LatinName {
+	int operator()(const char *key, const FruitData *fruitData) const
+	{
+		return strcmp(key, fruitData->latin);
+	}
+};
+
+extern "C" void
+searchInCommonNameTemplate(const FruitData *fruitDataArray, int nFruits, char *key)
+{
+	const FruitData *arrayResult = nullptr;
+
+	arrayResult = search::binarySearch((const char *) key,
+			fruitDataArray, nFruits, StructComparator_CommonName());
+	if (arrayResult != nullptr) {
+		printf("Common name search using '%s' returned:\n\t", key);
+		printFuitWithID(arrayResult, arrayResult - fruitDataArray);
+	} else {
+		printf("Common name search using '%s' FAILED\n", key);
+	}
+}
+
+extern "C" void
+searchInLatinNameTemplate(FruitData * const *fruitDataPointers, int nFruits, char *key)
+{
+	FruitData * const *pointerResult = nullptr;
+
+	pointerResult = search::binarySearch((const char *) key,
+			fruitDataPointers, nFruits, PointerComparator_LatinName());
+	if (pointerResult != nullptr) {
+		printf("Latin name search using '%s' returned:\n\t", key);
+		printFuitWithID(*pointerResult, pointerResult - fruitDataPointers);
+	} else {
+		printf("Latin name search using '%s' FAILED\n", key);
+	}
+}